@@ -0,0 +1,572 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#include "BenchmarkResults.hpp"
+
+#include <SoapySDR/Version.hpp>
+
+#include <volk/volk.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define HAVE_CPUID
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define HAVE_CPUID
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <locale>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace BenchmarkResults
+{
+    //
+    // Host information
+    //
+
+    static std::string trim(const std::string& str)
+    {
+        const auto begin = str.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) return "";
+
+        return str.substr(begin, (str.find_last_not_of(" \t\r\n") - begin + 1));
+    }
+
+    static std::string getCPUName()
+    {
+#ifdef HAVE_CPUID
+        // The brand string is in leaves 0x80000002-0x80000004, if supported.
+        unsigned int regs[12] = {0};
+#ifdef _MSC_VER
+        int maxLeaf[4];
+        __cpuid(maxLeaf, 0x80000000);
+        if (unsigned(maxLeaf[0]) >= 0x80000004)
+        {
+            for (int i = 0; i < 3; ++i) __cpuid(reinterpret_cast<int*>(regs + (i * 4)), (0x80000002 + i));
+        }
+#else
+        if (__get_cpuid_max(0x80000000, nullptr) >= 0x80000004)
+        {
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                __get_cpuid((0x80000002 + i), &regs[i * 4], &regs[(i * 4) + 1], &regs[(i * 4) + 2], &regs[(i * 4) + 3]);
+            }
+        }
+#endif
+        char brand[sizeof(regs) + 1] = {0};
+        std::memcpy(brand, regs, sizeof(regs));
+        if (brand[0]) return trim(brand);
+#endif
+
+        // Other architectures on Linux
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line))
+        {
+            const auto colon = line.find(':');
+            if (colon == std::string::npos) continue;
+
+            const auto key = trim(line.substr(0, colon));
+            if ((key == "model name") || (key == "Model") || (key == "Hardware")) return trim(line.substr(colon + 1));
+        }
+
+        return "unknown";
+    }
+
+    static std::string getTimestamp()
+    {
+        const std::time_t now = std::time(nullptr);
+        std::tm utc{};
+#ifdef _WIN32
+        gmtime_s(&utc, &now);
+#else
+        gmtime_r(&now, &utc);
+#endif
+        char buffer[32] = {0};
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+        return buffer;
+    }
+
+    HostInfo getHostInfo(const std::string& moduleVersion)
+    {
+        return HostInfo{
+            getCPUName(),
+            SoapySDR::getLibVersion(),
+            volk_version(),
+            volk_get_machine(),
+            moduleVersion,
+            getTimestamp()};
+    }
+
+    //
+    // Writing
+    //
+
+    static std::ofstream openOutput(const std::string& path)
+    {
+        std::ofstream out(path);
+        if (!out) throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+
+        return out;
+    }
+
+    static void closeOutput(std::ofstream& out, const std::string& path)
+    {
+        out.close();
+        if (!out) throw std::runtime_error("Failed to write " + path);
+    }
+
+    static std::string escapeJSON(const std::string& str)
+    {
+        std::ostringstream out;
+        for (const char ch: str)
+        {
+            switch (ch)
+            {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(ch);
+                else out << ch;
+            }
+        }
+
+        return out.str();
+    }
+
+    static void setFormat(std::ostream& out)
+    {
+        out.imbue(std::locale::classic());
+        out << std::setprecision(9);
+    }
+
+    void writeJSON(std::ostream& out, const HostInfo& host, const std::vector<Result>& results)
+    {
+        setFormat(out);
+
+        out << "{\n";
+        out << "  \"host\": {\n";
+        out << "    \"cpu\": \"" << escapeJSON(host.cpu) << "\",\n";
+        out << "    \"soapysdr_version\": \"" << escapeJSON(host.soapySDRVersion) << "\",\n";
+        out << "    \"volk_version\": \"" << escapeJSON(host.volkVersion) << "\",\n";
+        out << "    \"volk_machine\": \"" << escapeJSON(host.volkMachine) << "\",\n";
+        out << "    \"module_version\": \"" << escapeJSON(host.moduleVersion) << "\",\n";
+        out << "    \"timestamp\": \"" << escapeJSON(host.timestamp) << "\"\n";
+        out << "  },\n";
+        out << "  \"results\": [";
+
+        const char* separator = "\n";
+        for (const auto& result: results)
+        {
+            out << separator;
+            out << "    {\"mode\": \"" << escapeJSON(result.mode)
+                << "\", \"source\": \"" << escapeJSON(result.source)
+                << "\", \"target\": \"" << escapeJSON(result.target)
+                << "\", \"priority\": \"" << escapeJSON(result.priority)
+                << "\", \"elements\": " << result.numElems
+                << ", \"median_us\": " << result.medianUs
+                << ", \"mad_us\": " << result.medAbsDevUs
+                << ", \"cycles_per_elem\": " << result.cyclesPerElem
+                << ", \"iterations\": " << result.iterations
+                << ", \"kernels\": \"" << escapeJSON(result.kernels)
+                << "\", \"threads\": " << result.threads
+                << ", \"p99_us\": " << result.p99Us
+                << ", \"p999_us\": " << result.p999Us
+                << ", \"max_us\": " << result.maxUs << "}";
+            separator = ",\n";
+        }
+
+        out << "\n  ]\n";
+        out << "}\n";
+    }
+
+    void writeJSON(const std::string& path, const HostInfo& host, const std::vector<Result>& results)
+    {
+        auto out = openOutput(path);
+        writeJSON(out, host, results);
+        closeOutput(out, path);
+    }
+
+    void writeCSV(std::ostream& out, const HostInfo& host, const std::vector<Result>& results)
+    {
+        setFormat(out);
+
+        out << "# cpu: " << host.cpu << "\n";
+        out << "# soapysdr_version: " << host.soapySDRVersion << "\n";
+        out << "# volk_version: " << host.volkVersion << "\n";
+        out << "# volk_machine: " << host.volkMachine << "\n";
+        out << "# module_version: " << host.moduleVersion << "\n";
+        out << "# timestamp: " << host.timestamp << "\n";
+        out << "mode,source,target,priority,elements,median_us,mad_us,cycles_per_elem,iterations,kernels,threads,p99_us,p999_us,max_us\n";
+
+        for (const auto& result: results)
+        {
+            out << result.mode << "," << result.source << "," << result.target << "," << result.priority << ","
+                << result.numElems << "," << result.medianUs << "," << result.medAbsDevUs << ","
+                << result.cyclesPerElem << "," << result.iterations << "," << result.kernels << "," << result.threads << ","
+                << result.p99Us << "," << result.p999Us << "," << result.maxUs << "\n";
+        }
+    }
+
+    void writeCSV(const std::string& path, const HostInfo& host, const std::vector<Result>& results)
+    {
+        auto out = openOutput(path);
+        writeCSV(out, host, results);
+        closeOutput(out, path);
+    }
+
+    //
+    // Reading
+    //
+
+    // Just enough JSON for what writeJSON() produces, and edits to it.
+    struct JSONValue
+    {
+        enum class Type {Null, Bool, Number, String, Array, Object};
+
+        Type type{Type::Null};
+        double number{0.0};
+        std::string string;
+        std::vector<JSONValue> array;
+        std::vector<std::pair<std::string, JSONValue>> object;
+
+        const JSONValue* find(const std::string& key) const
+        {
+            for (const auto& member: object)
+            {
+                if (member.first == key) return &member.second;
+            }
+
+            return nullptr;
+        }
+    };
+
+    class JSONParser
+    {
+    public:
+        JSONParser(const std::string& text):
+            _text(text)
+        {
+        }
+
+        JSONValue parse()
+        {
+            auto value = _parseValue();
+            _skipWhitespace();
+            if (_pos != _text.size()) _fail("trailing characters");
+
+            return value;
+        }
+
+    private:
+        const std::string& _text;
+        size_t _pos{0};
+
+        [[noreturn]] void _fail(const std::string& what)
+        {
+            throw std::runtime_error("JSON parse error at offset " + std::to_string(_pos) + ": " + what);
+        }
+
+        void _skipWhitespace()
+        {
+            while ((_pos < _text.size()) && std::isspace(static_cast<unsigned char>(_text[_pos]))) ++_pos;
+        }
+
+        void _expect(const char ch)
+        {
+            _skipWhitespace();
+            if ((_pos >= _text.size()) || (_text[_pos] != ch)) _fail(std::string("expected '") + ch + "'");
+            ++_pos;
+        }
+
+        bool _consume(const char ch)
+        {
+            _skipWhitespace();
+            if ((_pos < _text.size()) && (_text[_pos] == ch))
+            {
+                ++_pos;
+                return true;
+            }
+
+            return false;
+        }
+
+        bool _consumeLiteral(const char* literal)
+        {
+            const size_t length = std::strlen(literal);
+            if (_text.compare(_pos, length, literal) != 0) return false;
+
+            _pos += length;
+            return true;
+        }
+
+        std::string _parseString()
+        {
+            _expect('"');
+
+            std::string str;
+            while (true)
+            {
+                if (_pos >= _text.size()) _fail("unterminated string");
+
+                const char ch = _text[_pos++];
+                if (ch == '"') break;
+                if (ch != '\\')
+                {
+                    str += ch;
+                    continue;
+                }
+
+                if (_pos >= _text.size()) _fail("unterminated escape");
+                const char escaped = _text[_pos++];
+                switch (escaped)
+                {
+                case 'n': str += '\n'; break;
+                case 'r': str += '\r'; break;
+                case 't': str += '\t'; break;
+                case 'b': str += '\b'; break;
+                case 'f': str += '\f'; break;
+                case 'u':
+                {
+                    // Only ASCII is ever written.
+                    if ((_pos + 4) > _text.size()) _fail("short \\u escape");
+                    str += char(std::stoi(_text.substr(_pos, 4), nullptr, 16) & 0x7F);
+                    _pos += 4;
+                    break;
+                }
+                default: str += escaped;
+                }
+            }
+
+            return str;
+        }
+
+        JSONValue _parseValue()
+        {
+            _skipWhitespace();
+            if (_pos >= _text.size()) _fail("unexpected end");
+
+            JSONValue value;
+            const char ch = _text[_pos];
+            if (ch == '{')
+            {
+                ++_pos;
+                value.type = JSONValue::Type::Object;
+                if (_consume('}')) return value;
+                do
+                {
+                    _skipWhitespace();
+                    auto key = _parseString();
+                    _expect(':');
+                    value.object.emplace_back(std::move(key), _parseValue());
+                } while (_consume(','));
+                _expect('}');
+            }
+            else if (ch == '[')
+            {
+                ++_pos;
+                value.type = JSONValue::Type::Array;
+                if (_consume(']')) return value;
+                do
+                {
+                    value.array.push_back(_parseValue());
+                } while (_consume(','));
+                _expect(']');
+            }
+            else if (ch == '"')
+            {
+                value.type = JSONValue::Type::String;
+                value.string = _parseString();
+            }
+            else if (_consumeLiteral("true"))
+            {
+                value.type = JSONValue::Type::Bool;
+                value.number = 1.0;
+            }
+            else if (_consumeLiteral("false"))
+            {
+                value.type = JSONValue::Type::Bool;
+            }
+            else if (_consumeLiteral("null"))
+            {
+                value.type = JSONValue::Type::Null;
+            }
+            else
+            {
+                // The benchmark never sets a locale, so strtod() parses '.'.
+                const char* begin = _text.c_str() + _pos;
+                char* end = nullptr;
+                value.number = std::strtod(begin, &end);
+                if (end == begin) _fail("invalid value");
+
+                value.type = JSONValue::Type::Number;
+                _pos += size_t(end - begin);
+            }
+
+            return value;
+        }
+    };
+
+    static std::string readFile(const std::string& path)
+    {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+
+        std::ostringstream contents;
+        contents << in.rdbuf();
+
+        return contents.str();
+    }
+
+    static const JSONValue& getMember(const JSONValue& object, const std::string& key, const JSONValue::Type type)
+    {
+        const auto* value = object.find(key);
+        if (!value || (value->type != type)) throw std::runtime_error("Result missing \"" + key + "\"");
+
+        return *value;
+    }
+
+    static std::vector<Result> readJSON(const std::string& path)
+    {
+        const auto text = readFile(path);
+        const auto root = JSONParser(text).parse();
+        if (root.type != JSONValue::Type::Object) throw std::runtime_error(path + " isn't a JSON object");
+
+        std::vector<Result> results;
+        for (const auto& value: getMember(root, "results", JSONValue::Type::Array).array)
+        {
+            // Fields added since the first format are optional.
+            auto getNumber = [&value](const char* key, double defaultValue)
+            {
+                const auto* member = value.find(key);
+                return member ? member->number : defaultValue;
+            };
+
+            const auto* kernels = value.find("kernels");
+            results.push_back(Result{
+                getMember(value, "mode", JSONValue::Type::String).string,
+                getMember(value, "source", JSONValue::Type::String).string,
+                getMember(value, "target", JSONValue::Type::String).string,
+                getMember(value, "priority", JSONValue::Type::String).string,
+                size_t(getMember(value, "elements", JSONValue::Type::Number).number),
+                getMember(value, "median_us", JSONValue::Type::Number).number,
+                getMember(value, "mad_us", JSONValue::Type::Number).number,
+                getNumber("cycles_per_elem", 0.0),
+                size_t(getNumber("iterations", 0.0)),
+                (kernels ? kernels->string : ""),
+                size_t(getNumber("threads", 1.0)),
+                getNumber("p99_us", 0.0),
+                getNumber("p999_us", 0.0),
+                getNumber("max_us", 0.0)});
+        }
+
+        return results;
+    }
+
+    static std::vector<Result> readCSV(const std::string& path)
+    {
+        std::istringstream in(readFile(path));
+        in.imbue(std::locale::classic());
+
+        std::vector<Result> results;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            line = trim(line);
+            if (line.empty() || (line[0] == '#') || (line.compare(0, 5, "mode,") == 0)) continue;
+
+            std::vector<std::string> fields;
+            std::istringstream lineIn(line);
+            std::string field;
+            while (std::getline(lineIn, field, ',')) fields.push_back(field);
+            if (fields.size() < 9) throw std::runtime_error("Invalid line in " + path + ": " + line);
+
+            results.push_back(Result{
+                fields[0],
+                fields[1],
+                fields[2],
+                fields[3],
+                size_t(std::stoull(fields[4])),
+                std::stod(fields[5]),
+                std::stod(fields[6]),
+                std::stod(fields[7]),
+                size_t(std::stoull(fields[8])),
+                (fields.size() > 9) ? fields[9] : "",
+                (fields.size() > 10) ? size_t(std::stoull(fields[10])) : 1,
+                (fields.size() > 11) ? std::stod(fields[11]) : 0.0,
+                (fields.size() > 12) ? std::stod(fields[12]) : 0.0,
+                (fields.size() > 13) ? std::stod(fields[13]) : 0.0});
+        }
+
+        return results;
+    }
+
+    static bool endsWith(const std::string& str, const std::string& suffix)
+    {
+        return (str.size() >= suffix.size()) && (str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0);
+    }
+
+    std::vector<Result> read(const std::string& path)
+    {
+        return endsWith(path, ".csv") ? readCSV(path) : readJSON(path);
+    }
+
+    //
+    // Comparison
+    //
+
+    size_t compare(const std::vector<Result>& baseline, const std::vector<Result>& results, double thresholdPercent)
+    {
+        std::cout << std::endl << "Compared to baseline (regression threshold " << thresholdPercent << "%):" << std::endl;
+
+        size_t numRegressions = 0;
+        size_t numCompared = 0;
+        for (const auto& result: results)
+        {
+            if (result.priority == "generic") continue;
+
+            const auto baselineIter = std::find_if(
+                baseline.begin(),
+                baseline.end(),
+                [&result](const Result& base)
+                {
+                    return (base.mode == result.mode) && (base.source == result.source) && (base.target == result.target) &&
+                           (base.priority == result.priority) && (base.numElems == result.numElems) &&
+                           (base.threads == result.threads);
+                });
+            if (baselineIter == baseline.end()) continue;
+
+            const double changePercent = 100.0 * ((result.medianUs / baselineIter->medianUs) - 1.0);
+            const bool regressed = (changePercent > thresholdPercent);
+
+            std::cout << " * " << result.source << " -> " << result.target << " (" << result.mode << ", "
+                      << result.numElems << " elements"
+                      << ((result.threads > 1) ? (", " + std::to_string(result.threads) + " threads") : "") << "): " << baselineIter->medianUs << "us -> " << result.medianUs
+                      << "us (" << std::showpos << changePercent << std::noshowpos << "%)"
+                      << (regressed ? " REGRESSION" : "") << std::endl;
+
+            ++numCompared;
+            if (regressed) ++numRegressions;
+        }
+
+        std::cout << numRegressions << " of " << numCompared << " compared results regressed" << std::endl;
+
+        return numRegressions;
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+//
+// Machine-readable benchmark results, written as JSON or CSV and read back
+// as a baseline to compare against.
+//
+namespace BenchmarkResults
+{
+    struct HostInfo
+    {
+        std::string cpu;
+        std::string soapySDRVersion;
+        std::string volkVersion;
+        std::string volkMachine;
+        std::string moduleVersion;
+        std::string timestamp; // UTC, ISO 8601
+    };
+
+    struct Result
+    {
+        // Which benchmark produced it, such as "convert" or "sweep". For
+        // "impls", source is the kernel, target the implementation, and
+        // priority "aligned" or "unaligned". For "startup", source is the
+        // load-time configuration and target what was timed.
+        std::string mode;
+        std::string source;
+        std::string target;
+        std::string priority; // "generic", "fast", or "vectorized"
+        size_t numElems;
+        double medianUs;
+        double medAbsDevUs;
+        double cyclesPerElem; // Timestamp counter cycles, or 0 without one
+        size_t iterations;
+
+        // The VOLK kernels the converter calls, and the implementations VOLK
+        // dispatches them to, as "kernel:aligned/unaligned" separated by ';'
+        std::string kernels;
+
+        // Converting concurrently, each with its own buffers
+        size_t threads{1};
+
+        // Tail latency, or 0 where it isn't measured
+        double p99Us{0.0};
+        double p999Us{0.0};
+        double maxUs{0.0};
+    };
+
+    HostInfo getHostInfo(const std::string& moduleVersion);
+
+    // Both throw on I/O errors.
+    void writeJSON(const std::string& path, const HostInfo& host, const std::vector<Result>& results);
+    void writeCSV(const std::string& path, const HostInfo& host, const std::vector<Result>& results);
+
+    void writeJSON(std::ostream& out, const HostInfo& host, const std::vector<Result>& results);
+    void writeCSV(std::ostream& out, const HostInfo& host, const std::vector<Result>& results);
+
+    // Reads results written by writeJSON() or writeCSV(), chosen by the
+    // file's extension. Throws if the file can't be read or parsed.
+    std::vector<Result> read(const std::string& path);
+
+    // Prints how each result compares to the baseline result with the same
+    // mode, pair, priority, size, and thread count, and returns the number of vectorized
+    // results slower than their baseline by more than thresholdPercent.
+    size_t compare(const std::vector<Result>& baseline, const std::vector<Result>& results, double thresholdPercent);
+}
@@ -1,171 +1,663 @@
 // Copyright (c) 2019-2021 Nicholas Corgan
 // SPDX-License-Identifier: GPL-3.0
 
+#include "BenchmarkResults.hpp"
+#include "CycleTimer.hpp"
+#include "PerfCounters.hpp"
+#include "SoapyVOLKConverters.hpp"
 #include "TestUtility.hpp"
 
 #include <SoapySDR/ConverterRegistry.hpp>
 #include <SoapySDR/Formats.hpp>
+#include <SoapySDR/Logger.hpp>
+#include <SoapySDR/Modules.hpp>
 #include <SoapySDR/Version.hpp>
 
 #include <volk/constants.h>
 #include <volk/volk.h>
-#include <volk/volk_prefs.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <cerrno>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
-static constexpr size_t numElements = 16384;
-static constexpr size_t numIterations = 10000;
+// Per call, unless a mode sets its own sizes
+static size_t numElements = 16384;
 
 //
-// Utility functions
+// Timing
 //
 
-static size_t numVolkArchPrefs = 0;
-static volk_arch_pref* volkArchPrefs = nullptr;
-static volk_arch_pref* volkArchPrefsEnd = nullptr;
+struct TimingOptions
+{
+    // A fixed number of calls, or 0 to call until the median's 95% confidence
+    // interval is within targetCIPercent of it
+    size_t iterations{0};
+    double targetCIPercent{1.0};
+    size_t minIterations{30};
+    size_t maxIterations{1000000};
+    std::chrono::milliseconds maxTime{2000};
+
+    // Spent calling before measuring, to warm caches and branch predictors
+    // and let the CPU settle on a clock speed
+    std::chrono::milliseconds warmup{10};
+};
+
+static TimingOptions timing;
+
+// Measured once the module is loaded
+static double ticksPerNs = 1.0;
+
+// Only opened with --perf, and only if the host allows it
+static std::unique_ptr<PerfCounters> perfCounters;
+
+struct Measurement
+{
+    double medianUs{0.0};
+    double medAbsDevUs{0.0};
+    double ciHalfWidthUs{0.0}; // Of the median, at 95%
+    double cyclesPerElem{0.0}; // Timestamp counter cycles, or 0 without one
+    size_t iterations{0};
+
+    // From hardware counters, NaN without them. Misses are per KB of input
+    // and output.
+    double ipc{NAN};
+    double bytesPerCycle{NAN};
+    double l1dMissesPerKB{NAN};
+    double llcMissesPerKB{NAN};
+    double branchMissesPerKB{NAN};
+};
+
+// The median's 95% confidence interval, from the ranks bounding it, so it
+// holds for skewed timings. Sorts values.
+template <typename T>
+static std::pair<T, T> getMedianCI(std::vector<T>& values)
+{
+    std::sort(values.begin(), values.end());
+
+    const double n = double(values.size());
+    const double spread = 1.96 * std::sqrt(n) / 2.0;
+    const size_t lower = size_t(std::max(0.0, std::floor((n / 2.0) - spread)));
+    const size_t upper = std::min(values.size() - 1, size_t(std::ceil((n / 2.0) + spread)));
+
+    return std::make_pair(values[lower], values[upper]);
+}
+
+template <typename T>
+static double getMedianCIHalfWidth(std::vector<T>& times)
+{
+    const auto ci = getMedianCI(times);
+    return double(ci.second - ci.first) / 2.0;
+}
 
-// This should only be called once, as volk_load_preferences resets the
-// global struct each time, even if it's loaded with the same file.
-void volkLoadPreferences()
+// Counts a separate run of calls, so the timing loop's own work doesn't
+// show up in the counts.
+template <typename CallFcn>
+static void countEvents(CallFcn call, size_t iterations, size_t bytesPerCall, Measurement& measurement)
 {
-    numVolkArchPrefs = volk_load_preferences(&volkArchPrefs);
-    volkArchPrefsEnd = volkArchPrefs + numVolkArchPrefs;
+    perfCounters->start();
+    for (size_t i = 0; i < iterations; ++i) call();
+    const auto counts = perfCounters->stop();
+
+    const double kb = double(iterations) * double(bytesPerCall) / 1024.0;
+
+    measurement.ipc = counts[PerfCounters::Instructions] / counts[PerfCounters::Cycles];
+    measurement.bytesPerCycle = double(iterations) * double(bytesPerCall) / counts[PerfCounters::Cycles];
+    measurement.l1dMissesPerKB = counts[PerfCounters::L1DMisses] / kb;
+    measurement.llcMissesPerKB = counts[PerfCounters::LLCMisses] / kb;
+    measurement.branchMissesPerKB = counts[PerfCounters::BranchMisses] / kb;
+}
+
+// Sorts ticks.
+static Measurement summarize(std::vector<uint64_t>& ticks, size_t numElems)
+{
+    volk::vector<double> times(ticks.size());
+    std::transform(ticks.begin(), ticks.end(), times.begin(), [](uint64_t t) { return (t / ticksPerNs / 1e3); });
+
+    Measurement measurement;
+    measurement.medianUs = TestUtility::median(times);
+    measurement.medAbsDevUs = TestUtility::medAbsDev(times);
+    measurement.ciHalfWidthUs = getMedianCIHalfWidth(ticks) / ticksPerNs / 1e3;
+#ifdef SOAPY_VOLK_HAVE_RDTSC
+    measurement.cyclesPerElem = double(ticks[ticks.size() / 2]) / double(numElems);
+#else
+    (void)numElems;
+#endif
+    measurement.iterations = ticks.size();
+
+    return measurement;
 }
 
-// Assumes preferences are loaded
-std::string getVolkMachineForFunc(const std::string& kernel)
+// Times each call separately with the cycle counter, after warming up.
+template <typename CallFcn>
+static Measurement measure(CallFcn call, size_t numElems, size_t bytesPerCall)
 {
-    auto prefsIter = std::find_if(
-                         volkArchPrefs,
-                         volkArchPrefsEnd,
-                         [&kernel](const volk_arch_pref& pref)
-                         {
-                            return (0 == strncmp(
-                                             kernel.c_str(),
-                                             pref.name,
-                                             sizeof(pref.name)));
-                         });
-    if(volkArchPrefsEnd == prefsIter)
+    using Clock = std::chrono::steady_clock;
+    using SoapyVOLKConverters::readCycleCounter;
+
+    const auto warmupEnd = Clock::now() + timing.warmup;
+    do call(); while (Clock::now() < warmupEnd);
+
+    const size_t maxIterations = (timing.iterations > 0) ? timing.iterations : timing.maxIterations;
+    const auto deadline = Clock::now() + timing.maxTime;
+
+    std::vector<uint64_t> ticks;
+    ticks.reserve(std::min<size_t>(maxIterations, 65536));
+
+    size_t nextCheck = std::max<size_t>(timing.minIterations, 1);
+    while (ticks.size() < maxIterations)
     {
-        std::cerr << "Could not find preferences for kernel " << kernel << "." << std::endl;
-        return "";
+        const uint64_t startTicks = readCycleCounter();
+        call();
+        ticks.push_back(readCycleCounter() - startTicks);
+
+        if ((timing.iterations > 0) || (ticks.size() < nextCheck)) continue;
+
+        // Checked as the count grows by a quarter, so sorting stays cheap.
+        nextCheck = ticks.size() + (ticks.size() / 4) + 1;
+
+        auto sorted = ticks;
+        const double halfWidth = getMedianCIHalfWidth(sorted);
+        const double median = double(sorted[sorted.size() / 2]);
+        if ((halfWidth <= (median * timing.targetCIPercent / 100.0)) || (Clock::now() >= deadline)) break;
     }
 
-    return std::string(prefsIter->impl_a);
+    auto measurement = summarize(ticks, numElems);
+    if (perfCounters) countEvents(call, measurement.iterations, bytesPerCall, measurement);
+
+    return measurement;
+}
+
+static void printMeasurement(const std::string& label, const Measurement& measurement)
+{
+    std::cout << label << measurement.medianUs << "us +- " << measurement.medAbsDevUs << "us ("
+              << measurement.iterations << " calls, median +- "
+              << (100.0 * measurement.ciHalfWidthUs / measurement.medianUs) << "% at 95%";
+    if (measurement.cyclesPerElem > 0.0) std::cout << ", " << measurement.cyclesPerElem << " cycles/element";
+    std::cout << ")" << std::endl;
+
+    if (!perfCounters) return;
+
+    const auto print = [](double value) { return std::isnan(value) ? std::string("n/a") : std::to_string(value); };
+
+    std::cout << std::string(label.size(), ' ') << "IPC " << print(measurement.ipc)
+              << ", " << print(measurement.bytesPerCycle) << " bytes/cycle"
+              << ", misses/KB: L1D " << print(measurement.l1dMissesPerKB)
+              << ", LLC " << print(measurement.llcMissesPerKB)
+              << ", branch " << print(measurement.branchMissesPerKB) << std::endl;
 }
 
-template <typename InType, typename OutType>
-void benchmarkConverter(
+static Measurement benchmarkConverter(
     const std::string& source,
     const std::string& target,
     SoapySDR::ConverterRegistry::FunctionPriority priority,
     double scalar,
-    double* pMedian,
-    double* pMedAbsDev)
+    const void* input,
+    size_t numElems)
 {
-    using Microseconds = std::chrono::duration<double, std::micro>;
-
     auto converterFunc = SoapySDR::ConverterRegistry::getFunction(
                              source,
                              target,
                              priority);
 
-    volk::vector<double> times;
-    times.reserve(numIterations);
+    volk::vector<uint8_t> output(numElems * SoapySDR::formatToSize(target));
+
+    return measure(
+        [&]()
+        {
+            converterFunc(
+                input,
+                output.data(),
+                numElems,
+                scalar);
+        },
+        numElems,
+        numElems * (SoapySDR::formatToSize(source) + SoapySDR::formatToSize(target)));
+}
+
+template <typename InType>
+static Measurement benchmarkConverter(
+    const std::string& source,
+    const std::string& target,
+    SoapySDR::ConverterRegistry::FunctionPriority priority,
+    double scalar,
+    const volk::vector<InType>& input)
+{
+    return benchmarkConverter(
+        source,
+        target,
+        priority,
+        scalar,
+        input.data(),
+        numElements);
+}
+
+//
+// Buffers
+//
+
+// Inputs for every mode
+static TestUtility::Signal signal = TestUtility::Signal::Uniform;
+static double snrDB = 20.0;
+
+template <typename T>
+static volk::vector<uint8_t> getInputBytes(size_t numElems)
+{
+    const auto values = TestUtility::getSignalValues<T>(signal, numElems, snrDB);
+
+    volk::vector<uint8_t> bytes(numElems * sizeof(T));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+
+    return bytes;
+}
 
-    const auto input = TestUtility::getRandomValues<InType>(numElements);
-    volk::vector<OutType> output(numElements);
+static volk::vector<uint8_t> getInputBuffer(const std::string& format, size_t numElems)
+{
+    if (format == SOAPY_SDR_S8) return getInputBytes<int8_t>(numElems);
+    if (format == SOAPY_SDR_S16) return getInputBytes<int16_t>(numElems);
+    if (format == SOAPY_SDR_S32) return getInputBytes<int32_t>(numElems);
+    if (format == SOAPY_SDR_F32) return getInputBytes<float>(numElems);
+    if (format == SOAPY_SDR_F64) return getInputBytes<double>(numElems);
+    if (format == SOAPY_SDR_CS8) return getInputBytes<std::complex<int8_t>>(numElems);
+    if (format == SOAPY_SDR_CS16) return getInputBytes<std::complex<int16_t>>(numElems);
+    if (format == SOAPY_SDR_CS32) return getInputBytes<std::complex<int32_t>>(numElems);
+    if (format == SOAPY_SDR_CF32) return getInputBytes<std::complex<float>>(numElems);
+    if (format == SOAPY_SDR_CF64) return getInputBytes<std::complex<double>>(numElems);
+
+    throw std::invalid_argument("Unsupported format " + format);
+}
+
+// Bursts of inputs separated by runs of exact zeros, like a burst
+// transmitter's TX buffers
+static volk::vector<uint8_t> getSparseBurstBuffer(const std::string& format, size_t numElems, size_t burstLength, size_t period)
+{
+    auto bytes = getInputBuffer(format, numElems);
 
-    for(size_t i = 0; i < numIterations; ++i)
+    const size_t elemSize = SoapySDR::formatToSize(format);
+    for (size_t i = 0; i < numElems; ++i)
     {
-        auto startTime = std::chrono::system_clock::now();
+        if ((i % period) >= burstLength) std::memset(bytes.data() + (i * elemSize), 0, elemSize);
+    }
 
-        converterFunc(
-            input.data(),
-            output.data(),
-            numElements,
-            scalar);
+    return bytes;
+}
+
+static double getFullScale(const std::string& format)
+{
+    const std::string real = (format[0] == 'C') ? format.substr(1) : format;
+    if (real == SOAPY_SDR_S8) return TestUtility::S8FullScale;
+    if (real == SOAPY_SDR_S16) return TestUtility::S16FullScale;
+    if (real == SOAPY_SDR_S32) return TestUtility::S32FullScale;
+
+    return 1.0;
+}
+
+// Scales integers to and from [-1, 1), as the hand-written pairs above do.
+static double getScalar(const std::string& source, const std::string& target)
+{
+    return getFullScale(target) / getFullScale(source);
+}
+
+//
+// Results
+//
+
+static std::vector<BenchmarkResults::Result> results;
+
+// As listed by the module, for this host
+static std::string getKernelDescription(
+    const std::string& source,
+    const std::string& target,
+    SoapySDR::ConverterRegistry::FunctionPriority priority = SoapySDR::ConverterRegistry::VECTORIZED)
+{
+    auto getKernelInfo = GET_MODULE_FUNCTION(SoapyVOLKConverters_getKernelInfo);
 
-        auto endTime = std::chrono::system_clock::now();
-        Microseconds iterationTime = endTime-startTime;
-        times.emplace_back(iterationTime.count());
+    std::vector<SoapyVOLKConvertersKernelInfo> allInfo(getKernelInfo(nullptr, 0));
+    getKernelInfo(allInfo.data(), allInfo.size());
+
+    std::string description;
+    for (const auto& info: allInfo)
+    {
+        if ((source != info.sourceFormat) || (target != info.targetFormat) || (info.priority != priority)) continue;
+        if (!info.kernel[0]) continue;
+
+        if (!description.empty()) description += ";";
+        description += std::string(info.kernel) + ":" + info.alignedImpl + "/" + info.unalignedImpl;
     }
 
-    (*pMedian) = TestUtility::median(times);
-    (*pMedAbsDev) = TestUtility::medAbsDev(times);
+    return description;
 }
 
-template <typename InType, typename OutType>
-void compareConverters(
+static void recordResult(
+    const std::string& mode,
     const std::string& source,
     const std::string& target,
-    double scalar,
-    const std::string& volkKernelName)
+    SoapySDR::ConverterRegistry::FunctionPriority priority,
+    size_t numElems,
+    const Measurement& measurement)
+{
+    const bool generic = (priority == SoapySDR::ConverterRegistry::GENERIC);
+    const bool fast = (priority == SoapyVOLKConverters::FastPriority);
+
+    results.push_back(BenchmarkResults::Result{
+        mode,
+        source,
+        target,
+        (generic ? "generic" : (fast ? "fast" : "vectorized")),
+        numElems,
+        measurement.medianUs,
+        measurement.medAbsDevUs,
+        measurement.cyclesPerElem,
+        measurement.iterations,
+        (generic ? "" : getKernelDescription(source, target, priority))});
+}
+
+// Statistics add per-call work SoapySDR's generic converters don't do, so
+// they're disabled while timing, and only enabled for calls the benchmark
+// reads them from.
+static void setStatsEnabled(bool enabled)
+{
+    auto setEnabled = GET_MODULE_FUNCTION(SoapyVOLKConverters_setStatsEnabled);
+    setEnabled(enabled);
+}
+
+static SoapyVOLKConvertersStats getVectorizedStats(
+    const std::string& source,
+    const std::string& target)
+{
+    auto getStats = GET_MODULE_FUNCTION(SoapyVOLKConverters_getStats);
+
+    std::vector<SoapyVOLKConvertersStats> allStats(getStats(nullptr, 0));
+    getStats(allStats.data(), allStats.size());
+
+    for (const auto& stats: allStats)
+    {
+        if ((source == stats.sourceFormat) && (target == stats.targetFormat) && (stats.priority == SoapySDR::ConverterRegistry::VECTORIZED))
+        {
+            return stats;
+        }
+    }
+
+    throw std::runtime_error("No statistics for " + source + " -> " + target);
+}
+
+// Scratch allocations are counted over one call with statistics enabled.
+// RSS is the whole process's peak so far, so it only grows when a pair needs
+// more memory than any before it.
+static void printMemoryStats(
+    const std::string& source,
+    const std::string& target,
+    const void* input,
+    size_t numElems)
+{
+    auto resetStats = GET_MODULE_FUNCTION(SoapyVOLKConverters_resetStats);
+    auto converterFunc = SoapySDR::ConverterRegistry::getFunction(source, target, SoapySDR::ConverterRegistry::VECTORIZED);
+    volk::vector<uint8_t> output(numElems * SoapySDR::formatToSize(target));
+
+    resetStats();
+    setStatsEnabled(true);
+    converterFunc(input, output.data(), numElems, getScalar(source, target));
+    setStatsEnabled(false);
+
+    const auto stats = getVectorizedStats(source, target);
+    const double allocsPerCall = (stats.calls > 0) ? (double(stats.allocations) / stats.calls) : 0.0;
+
+    std::cout << "Allocations: " << allocsPerCall << " per call, peak scratch " << stats.peakScratchBytes << " bytes" << std::endl;
+    std::cout << "Peak RSS:    " << (TestUtility::getPeakRSSBytes() / 1048576.0) << " MB" << std::endl;
+}
+
+//
+// Pairs
+//
+
+// From --pairs, as source and target formats, where "*" matches any
+static std::vector<std::pair<std::string, std::string>> pairFilters;
+
+static bool isSelected(const std::string& source, const std::string& target)
+{
+    if (pairFilters.empty()) return true;
+
+    for (const auto& filter: pairFilters)
+    {
+        if (((filter.first == "*") || (filter.first == source)) && ((filter.second == "*") || (filter.second == target))) return true;
+    }
+
+    return false;
+}
+
+static bool hasPriority(
+    const std::string& source,
+    const std::string& target,
+    int priority)
+{
+    const auto priorities = SoapySDR::ConverterRegistry::listPriorities(source, target);
+    return (std::find(priorities.begin(), priorities.end(), priority) != priorities.end());
+}
+
+// Every selected pair with a vectorized converter, which in practice are
+// this module's, so new converters are benchmarked without listing them.
+static std::vector<std::pair<std::string, std::string>> listPairs()
+{
+    std::vector<std::pair<std::string, std::string>> pairs;
+    for (const auto& source: SoapySDR::ConverterRegistry::listAvailableSourceFormats())
+    {
+        for (const auto& target: SoapySDR::ConverterRegistry::listTargetFormats(source))
+        {
+            if (isSelected(source, target) && hasPriority(source, target, SoapySDR::ConverterRegistry::VECTORIZED))
+            {
+                pairs.emplace_back(source, target);
+            }
+        }
+    }
+
+    return pairs;
+}
+
+// Against SoapySDR's generic converter where there is one, and the fast
+// variant where the module registers one
+static void benchmarkPair(
+    const std::string& source,
+    const std::string& target)
 {
-    double genericMedianTime, genericMedAbsDevTime;
-    double vectorizedMedianTime, vectorizedMedAbsDevTime;
+    const double scalar = getScalar(source, target);
 
     std::cout << std::endl << source << " -> " << target << " (scaled x" << scalar << ")" << std::endl;
 
     try
     {
-        benchmarkConverter<InType, OutType>(
+        const auto input = getInputBuffer(source, numElements);
+
+        const auto vectorized = benchmarkConverter(
+            source,
+            target,
+            SoapySDR::ConverterRegistry::VECTORIZED,
+            scalar,
+            input.data(),
+            numElements);
+        recordResult("convert", source, target, SoapySDR::ConverterRegistry::VECTORIZED, numElements, vectorized);
+
+        if (hasPriority(source, target, SoapySDR::ConverterRegistry::GENERIC))
+        {
+            const auto generic = benchmarkConverter(
+                source,
+                target,
+                SoapySDR::ConverterRegistry::GENERIC,
+                scalar,
+                input.data(),
+                numElements);
+            recordResult("convert", source, target, SoapySDR::ConverterRegistry::GENERIC, numElements, generic);
+
+            printMeasurement("Generic:    ", generic);
+            printMeasurement("Vectorized: ", vectorized);
+            std::cout << (generic.medianUs / vectorized.medianUs) << "x faster than generic" << std::endl;
+        }
+        else printMeasurement("Vectorized: ", vectorized);
+
+        if (hasPriority(source, target, SoapyVOLKConverters::FastPriority))
+        {
+            const auto fast = benchmarkConverter(
+                source,
+                target,
+                SoapyVOLKConverters::FastPriority,
+                scalar,
+                input.data(),
+                numElements);
+            recordResult("convert", source, target, SoapyVOLKConverters::FastPriority, numElements, fast);
+
+            printMeasurement("Fast:       ", fast);
+            std::cout << (vectorized.medianUs / fast.medianUs) << "x faster than vectorized" << std::endl;
+        }
+
+        const auto kernels = getKernelDescription(source, target);
+        if (!kernels.empty()) std::cout << "Kernels:    " << kernels << std::endl;
+        printMemoryStats(source, target, input.data(), numElements);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+    }
+}
+
+// Compares a TX converter on dense input against input that's mostly zeros,
+// with short bursts, as sent by a burst transmitter.
+static void benchmarkSparseBurst(
+    const std::string& source,
+    const std::string& target)
+{
+    static constexpr size_t burstLength = 1024;
+    static constexpr size_t burstPeriod = 8192;
+
+    const double scalar = getScalar(source, target);
+
+    std::cout << std::endl << source << " -> " << target << " (scaled x" << scalar
+              << ", bursts of " << burstLength << "/" << burstPeriod << ")" << std::endl;
+
+    try
+    {
+        const auto denseInput = getInputBuffer(source, numElements);
+        const auto sparseInput = getSparseBurstBuffer(source, numElements, burstLength, burstPeriod);
+
+        auto getZeroSkipBlockCount = GET_MODULE_FUNCTION(SoapyVOLKConverters_getZeroSkipBlockCount);
+        auto converterFunc = SoapySDR::ConverterRegistry::getFunction(source, target, SoapySDR::ConverterRegistry::VECTORIZED);
+
+        const auto dense = benchmarkConverter(
             source,
             target,
-            SoapySDR::ConverterRegistry::GENERIC,
+            SoapySDR::ConverterRegistry::VECTORIZED,
             scalar,
-            &genericMedianTime,
-            &genericMedAbsDevTime);
-        benchmarkConverter<InType, OutType>(
+            denseInput.data(),
+            numElements);
+
+        const auto sparse = benchmarkConverter(
             source,
             target,
             SoapySDR::ConverterRegistry::VECTORIZED,
             scalar,
-            &vectorizedMedianTime,
-            &vectorizedMedAbsDevTime);
-        std::cout << "Generic:    " << genericMedianTime << "us +- " << genericMedAbsDevTime << "us" << std::endl;
-        std::cout << "Vectorized: " << vectorizedMedianTime << "us +- " << vectorizedMedAbsDevTime << "us" << std::endl;
-        std::cout << "Machine:    " << getVolkMachineForFunc(volkKernelName) << std::endl;
-        std::cout << (genericMedianTime / vectorizedMedianTime) << "x faster" << std::endl;
+            sparseInput.data(),
+            numElements);
+
+        // Every call skips the same blocks, so count one.
+        volk::vector<uint8_t> output(numElements * SoapySDR::formatToSize(target));
+        const uint64_t skippedBefore = getZeroSkipBlockCount();
+        converterFunc(sparseInput.data(), output.data(), numElements, scalar);
+        const uint64_t skipped = getZeroSkipBlockCount() - skippedBefore;
+
+        recordResult("sparse_burst", source, target, SoapySDR::ConverterRegistry::VECTORIZED, numElements, sparse);
+
+        printMeasurement("Dense:          ", dense);
+        printMeasurement("Sparse:         ", sparse);
+        std::cout << "Skipped blocks: " << skipped << " per call" << std::endl;
+        std::cout << (dense.medianUs / sparse.medianUs) << "x faster" << std::endl;
     }
     catch (const std::exception& ex)
     {
         std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
     }
-    catch (...)
-    {
-        std::cerr << "Unknown exception caught." << std::endl;
-    }
 }
 
-template <typename InType, typename OutType>
-void benchmarkVectorizedOnly(
+//
+// Stages
+//
+
+// Splits a two-stage F64 converter's time into allocating and freeing the
+// intermediate buffer and its two kernels, next to the single-stage converter
+// that shares one of its kernels.
+static void benchmarkStages(
     const std::string& source,
     const std::string& target,
-    double scalar,
-    const std::string& volkKernelName)
+    const std::string& singleSource,
+    const std::string& singleTarget)
 {
-    double medianTime, medAbsDevTime;
+    if (!isSelected(source, target)) return;
+
+    const double scalar = getScalar(source, target);
 
     std::cout << std::endl << source << " -> " << target << " (scaled x" << scalar << ")" << std::endl;
 
     try
     {
-        benchmarkConverter<InType, OutType>(
+        auto resetStats = GET_MODULE_FUNCTION(SoapyVOLKConverters_resetStats);
+        auto setStageTimingEnabled = GET_MODULE_FUNCTION(SoapyVOLKConverters_setStageTimingEnabled);
+
+        const auto input = getInputBuffer(source, numElements);
+        const auto singleInput = getInputBuffer(singleSource, numElements);
+
+        // Stage timing is read from statistics, so this mode times with them.
+        resetStats();
+        setStatsEnabled(true);
+        setStageTimingEnabled(true);
+        benchmarkConverter(
             source,
             target,
             SoapySDR::ConverterRegistry::VECTORIZED,
             scalar,
-            &medianTime,
-            &medAbsDevTime);
-        std::cout << "Vectorized: " << medianTime << "us +- " << medAbsDevTime << "us" << std::endl;
-        std::cout << "Machine:    " << getVolkMachineForFunc(volkKernelName) << std::endl;
+            input);
+        benchmarkConverter(
+            singleSource,
+            singleTarget,
+            SoapySDR::ConverterRegistry::VECTORIZED,
+            getScalar(singleSource, singleTarget),
+            singleInput);
+        setStageTimingEnabled(false);
+        setStatsEnabled(false);
+
+        const auto stats = getVectorizedStats(source, target);
+        const auto singleStats = getVectorizedStats(singleSource, singleTarget);
+        if ((stats.stageTimedCalls == 0) || (singleStats.calls == 0))
+        {
+            std::cerr << "No calls recorded" << std::endl;
+            return;
+        }
+
+        const double totalUs = stats.nanoseconds / 1e3 / stats.calls;
+        const double stagesUs[] =
+        {
+            (stats.allocNanoseconds / 1e3 / stats.stageTimedCalls),
+            (stats.firstStageNanoseconds / 1e3 / stats.stageTimedCalls),
+            (stats.secondStageNanoseconds / 1e3 / stats.stageTimedCalls)
+        };
+        const double singleUs = singleStats.nanoseconds / 1e3 / singleStats.calls;
+
+        std::cout << "Alloc/free:   " << stagesUs[0] << "us (" << (100.0 * stagesUs[0] / totalUs) << "%)" << std::endl;
+        std::cout << "First stage:  " << stagesUs[1] << "us (" << (100.0 * stagesUs[1] / totalUs) << "%)" << std::endl;
+        std::cout << "Second stage: " << stagesUs[2] << "us (" << (100.0 * stagesUs[2] / totalUs) << "%)" << std::endl;
+        std::cout << "Total:        " << totalUs << "us" << std::endl;
+        std::cout << singleSource << " -> " << singleTarget << ": " << singleUs << "us ("
+                  << (totalUs / singleUs) << "x faster)" << std::endl;
     }
     catch (const std::exception& ex)
     {
@@ -177,213 +669,1742 @@ void benchmarkVectorizedOnly(
     }
 }
 
-int main(int, char**)
+// Every vectorized converter that calls two kernels, paired with a
+// single-kernel converter calling one of them, preferring one with the same
+// source or target format.
+static void benchmarkAllStages()
+{
+    using Pair = std::pair<std::string, std::string>;
+
+    auto getKernelInfo = GET_MODULE_FUNCTION(SoapyVOLKConverters_getKernelInfo);
+
+    std::vector<SoapyVOLKConvertersKernelInfo> allInfo(getKernelInfo(nullptr, 0));
+    getKernelInfo(allInfo.data(), allInfo.size());
+
+    // Kernels per vectorized converter, in registration order
+    std::vector<std::pair<Pair, std::vector<std::string>>> converters;
+    for (const auto& info: allInfo)
+    {
+        if ((info.priority != SoapySDR::ConverterRegistry::VECTORIZED) || !info.kernel[0]) continue;
+
+        const Pair pair(info.sourceFormat, info.targetFormat);
+        if (converters.empty() || (converters.back().first != pair)) converters.emplace_back(pair, std::vector<std::string>());
+        converters.back().second.push_back(info.kernel);
+    }
+
+    std::cout << std::endl << "Two-stage converters (mean per call):" << std::endl;
+
+    for (const auto& converter: converters)
+    {
+        if (converter.second.size() != 2) continue;
+
+        const Pair* single = nullptr;
+        for (const auto& candidate: converters)
+        {
+            if (candidate.second.size() != 1) continue;
+            if (std::find(converter.second.begin(), converter.second.end(), candidate.second.front()) == converter.second.end()) continue;
+
+            const bool sharesFormat = (candidate.first.first == converter.first.first) || (candidate.first.second == converter.first.second);
+            if (!single || sharesFormat) single = &candidate.first;
+            if (sharesFormat) break;
+        }
+
+        if (!single)
+        {
+            std::cout << std::endl << converter.first.first << " -> " << converter.first.second << ": no single-stage converter shares a kernel" << std::endl;
+            continue;
+        }
+
+        benchmarkStages(converter.first.first, converter.first.second, single->first, single->second);
+    }
+}
+
+//
+// Buffer size sweep
+//
+
+struct SweepPoint
+{
+    size_t numElems;
+    double genericUs;
+    double vectorizedUs;
+};
+
+// The smallest size from which the vectorized converter is faster at every
+// larger size, or 0 if it's slower at the largest.
+static size_t getCrossoverSize(const std::vector<SweepPoint>& points)
+{
+    size_t crossover = 0;
+    for (auto it = points.rbegin(); it != points.rend(); ++it)
+    {
+        if (it->vectorizedUs >= it->genericUs) break;
+        crossover = it->numElems;
+    }
+
+    return crossover;
+}
+
+static void sweepConverter(
+    const std::string& source,
+    const std::string& target,
+    size_t minElems,
+    size_t maxElems)
 {
+    const auto priorities = SoapySDR::ConverterRegistry::listPriorities(source, target);
+    const bool hasGeneric = (std::find(priorities.begin(), priorities.end(), SoapySDR::ConverterRegistry::GENERIC) != priorities.end());
+    const double scalar = getScalar(source, target);
+    const double bytesPerElem = double(SoapySDR::formatToSize(source) + SoapySDR::formatToSize(target));
+
+    std::cout << std::endl << source << " -> " << target << " (scaled x" << scalar << ")" << std::endl;
+
     try
     {
-        if (!TestUtility::loadSoapyVOLK()) return EXIT_FAILURE;
+        const auto input = getInputBuffer(source, maxElems);
 
-        // Places values in global variables
-        volkLoadPreferences();
+        std::cout << std::setw(10) << "Elements" << std::setw(14) << "Generic MS/s"
+                  << std::setw(14) << "VOLK MS/s" << std::setw(12) << "VOLK GB/s" << std::setw(14) << "VOLK cyc/elem"
+                  << std::setw(10) << "Speedup" << std::endl;
 
-        //std::cout << "SoapyVOLKConverters " << SoapySDR::getModuleVersion(modulePath) << std::endl;
-        std::cout << "SoapySDR            " << SoapySDR::getLibVersion() << std::endl;
-        std::cout << "VOLK                " << volk_version() << std::endl;
+        std::vector<SweepPoint> points;
+        for (size_t numElems = minElems; numElems <= maxElems; numElems *= 2)
+        {
+            const auto vectorized = benchmarkConverter(
+                source,
+                target,
+                SoapySDR::ConverterRegistry::VECTORIZED,
+                scalar,
+                input.data(),
+                numElems);
+            recordResult("sweep", source, target, SoapySDR::ConverterRegistry::VECTORIZED, numElems, vectorized);
 
-        std::cout << std::endl;
-        std::cout << "Stats:" << std::endl;
-        std::cout << " * Buffer size:  " << numElements << std::endl;
-        std::cout << " * # iterations: " << numIterations << std::endl;
-
-        // int8_t
-        compareConverters<int8_t, int16_t>(
-            SOAPY_SDR_S8,
-            SOAPY_SDR_S16,
-            1.0, // No scaling
-            "volk_16i_convert_8i");
-        compareConverters<int8_t, float>(
-            SOAPY_SDR_S8,
-            SOAPY_SDR_F32,
-            TestUtility::S8ToF32Scalar,
-            "volk_8i_s32f_convert_32f");
-        benchmarkVectorizedOnly<int8_t, double>(
-            SOAPY_SDR_S8,
-            SOAPY_SDR_F64,
-            TestUtility::S8ToF32Scalar,
-            "volk_8i_s32f_convert_32f");
-
-        // int16_t
-        compareConverters<int16_t, int8_t>(
-            SOAPY_SDR_S16,
-            SOAPY_SDR_S8,
-            1.0, // No scaling
-            "volk_16i_convert_8i");
-        compareConverters<int16_t, float>(
-            SOAPY_SDR_S16,
-            SOAPY_SDR_F32,
-            TestUtility::S16ToF32Scalar,
-            "volk_16i_s32f_convert_32f");
-        benchmarkVectorizedOnly<int16_t, double>(
-            SOAPY_SDR_S16,
-            SOAPY_SDR_F64,
-            TestUtility::S16ToF32Scalar,
-            "volk_16i_s32f_convert_32f");
-
-        // int32_t
-        benchmarkVectorizedOnly<int32_t, float>(
-            SOAPY_SDR_S32,
-            SOAPY_SDR_F32,
-            TestUtility::S32ToF32Scalar,
-            "volk_32i_s32f_convert_32f");
-        benchmarkVectorizedOnly<int32_t, double>(
-            SOAPY_SDR_S32,
-            SOAPY_SDR_F64,
-            TestUtility::S32ToF32Scalar,
-            "volk_32i_s32f_convert_32f");
-
-        // float
-        compareConverters<float, int8_t>(
-            SOAPY_SDR_F32,
-            SOAPY_SDR_S8,
-            TestUtility::F32ToS8Scalar,
-            "volk_32f_s32f_convert_8i");
-        compareConverters<float, int16_t>(
-            SOAPY_SDR_F32,
-            SOAPY_SDR_S16,
-            TestUtility::F32ToS16Scalar,
-            "volk_32f_s32f_convert_16i");
-        benchmarkVectorizedOnly<float, int32_t>(
-            SOAPY_SDR_F32,
-            SOAPY_SDR_S32,
-            TestUtility::F32ToS32Scalar,
-            "volk_32f_s32f_convert_32i");
-        compareConverters<float, float>(
-            SOAPY_SDR_F32,
-            SOAPY_SDR_F32,
-            10.0,
-            "volk_32f_s32f_multiply_32f");
-        benchmarkVectorizedOnly<float, double>(
-            SOAPY_SDR_F32,
-            SOAPY_SDR_F64,
-            1.0,
-            "volk_32f_convert_64f");
-
-        // double
-        benchmarkVectorizedOnly<double, int8_t>(
-            SOAPY_SDR_F64,
-            SOAPY_SDR_S8,
-            TestUtility::F32ToS8Scalar,
-            "volk_32f_s32f_convert_8i");
-        benchmarkVectorizedOnly<double, int16_t>(
-            SOAPY_SDR_F64,
-            SOAPY_SDR_S16,
-            TestUtility::F32ToS16Scalar,
-            "volk_32f_s32f_convert_16i");
-        benchmarkVectorizedOnly<double, int32_t>(
-            SOAPY_SDR_F64,
-            SOAPY_SDR_S32,
-            TestUtility::F32ToS32Scalar,
-            "volk_32f_s32f_convert_32i");
-        benchmarkVectorizedOnly<double, float>(
-            SOAPY_SDR_F64,
-            SOAPY_SDR_F32,
-            10.0,
-            "volk_32f_s32f_multiply_32f");
-
-        // std::complex<int8_t>
-        compareConverters<std::complex<int8_t>, std::complex<int16_t>>(
-            SOAPY_SDR_CS8,
-            SOAPY_SDR_CS16,
-            1.0, // No scaling
-            "volk_16i_convert_8i");
-        compareConverters<std::complex<int8_t>, std::complex<float>>(
-            SOAPY_SDR_CS8,
-            SOAPY_SDR_CF32,
-            TestUtility::S8ToF32Scalar,
-            "volk_8i_s32f_convert_32f");
-        benchmarkVectorizedOnly<std::complex<int8_t>, std::complex<double>>(
-            SOAPY_SDR_CS8,
-            SOAPY_SDR_CF64,
-            TestUtility::S8ToF32Scalar,
-            "volk_8i_s32f_convert_32f");
-
-        // std::complex<int16_t>
-        compareConverters<std::complex<int16_t>, std::complex<int8_t>>(
-            SOAPY_SDR_CS16,
-            SOAPY_SDR_CS8,
-            1.0, // No scaling
-            "volk_16i_convert_8i");
-        compareConverters<std::complex<int16_t>, std::complex<float>>(
-            SOAPY_SDR_CS16,
-            SOAPY_SDR_CF32,
-            TestUtility::S16ToF32Scalar,
-            "volk_16i_s32f_convert_32f");
-        benchmarkVectorizedOnly<std::complex<int16_t>, std::complex<double>>(
-            SOAPY_SDR_CS16,
-            SOAPY_SDR_CF64,
-            TestUtility::S16ToF32Scalar,
-            "volk_16i_s32f_convert_32f");
-
-        // std::complex<int32_t>
-        benchmarkVectorizedOnly<std::complex<int32_t>, std::complex<float>>(
-            SOAPY_SDR_CS32,
-            SOAPY_SDR_CF32,
-            TestUtility::S32ToF32Scalar,
-            "volk_32i_s32f_convert_32f");
-        benchmarkVectorizedOnly<std::complex<int32_t>, std::complex<double>>(
-            SOAPY_SDR_CS32,
-            SOAPY_SDR_CF64,
-            TestUtility::S32ToF32Scalar,
-            "volk_32i_s32f_convert_32f");
-
-        // std::complex<float>
-        compareConverters<std::complex<float>, std::complex<int8_t>>(
-            SOAPY_SDR_CF32,
-            SOAPY_SDR_CS8,
-            TestUtility::F32ToS8Scalar,
-            "volk_32f_s32f_convert_8i");
-        compareConverters<std::complex<float>, std::complex<int16_t>>(
-            SOAPY_SDR_CF32,
-            SOAPY_SDR_CS16,
-            TestUtility::F32ToS16Scalar,
-            "volk_32f_s32f_convert_16i");
-        benchmarkVectorizedOnly<std::complex<float>, std::complex<int32_t>>(
-            SOAPY_SDR_CF32,
-            SOAPY_SDR_CS32,
-            TestUtility::F32ToS32Scalar,
-            "volk_32f_s32f_convert_32i");
-        compareConverters<std::complex<float>, std::complex<float>>(
-            SOAPY_SDR_CF32,
-            SOAPY_SDR_CF32,
-            10.0,
-            "volk_32f_s32f_multiply_32f");
-        benchmarkVectorizedOnly<std::complex<float>, std::complex<double>>(
-            SOAPY_SDR_CF32,
-            SOAPY_SDR_CF64,
-            1.0,
-            "volk_32f_convert_64f");
-
-        // std::complex<double>
-        benchmarkVectorizedOnly<std::complex<double>, std::complex<int8_t>>(
-            SOAPY_SDR_CF64,
-            SOAPY_SDR_CS8,
-            TestUtility::F32ToS8Scalar,
-            "volk_32f_s32f_convert_8i");
-        benchmarkVectorizedOnly<std::complex<double>, std::complex<int16_t>>(
-            SOAPY_SDR_CF64,
-            SOAPY_SDR_CS16,
-            TestUtility::F32ToS16Scalar,
-            "volk_32f_s32f_convert_16i");
-        benchmarkVectorizedOnly<std::complex<double>, std::complex<int32_t>>(
-            SOAPY_SDR_CF64,
-            SOAPY_SDR_CS32,
-            TestUtility::F32ToS32Scalar,
-            "volk_32f_s32f_convert_32i");
-        benchmarkVectorizedOnly<std::complex<double>, std::complex<float>>(
-            SOAPY_SDR_CF64,
-            SOAPY_SDR_CF32,
-            10.0,
-            "volk_32f_s32f_multiply_32f");
+            SweepPoint point{numElems, 0.0, vectorized.medianUs};
+            if (hasGeneric)
+            {
+                const auto generic = benchmarkConverter(
+                    source,
+                    target,
+                    SoapySDR::ConverterRegistry::GENERIC,
+                    scalar,
+                    input.data(),
+                    numElems);
+                recordResult("sweep", source, target, SoapySDR::ConverterRegistry::GENERIC, numElems, generic);
+
+                point.genericUs = generic.medianUs;
+            }
+            points.push_back(point);
+
+            // Elements per microsecond are megasamples per second.
+            const double vectorizedMSps = numElems / point.vectorizedUs;
+
+            std::cout << std::setw(10) << numElems;
+            if (hasGeneric) std::cout << std::setw(14) << (numElems / point.genericUs);
+            else std::cout << std::setw(14) << "-";
+            std::cout << std::setw(14) << vectorizedMSps << std::setw(12) << (vectorizedMSps * bytesPerElem / 1e3)
+                      << std::setw(14) << vectorized.cyclesPerElem;
+            if (hasGeneric) std::cout << std::setw(10) << (point.genericUs / point.vectorizedUs) << "x";
+            std::cout << std::endl;
+        }
+
+        if (!hasGeneric) return;
+
+        const size_t crossover = getCrossoverSize(points);
+        if (crossover == 0) std::cout << "Crossover:  none, generic is faster at " << maxElems << " elements" << std::endl;
+        else if (crossover == minElems) std::cout << "Crossover:  VOLK is faster at every size" << std::endl;
+        else std::cout << "Crossover:  VOLK is faster from " << crossover << " elements" << std::endl;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception caught." << std::endl;
+    }
+}
+
+static void sweepAllConverters(size_t minElems, size_t maxElems)
+{
+    std::cout << std::endl << "Buffer size sweep (median per call):" << std::endl;
+
+    for (const auto& pair: listPairs()) sweepConverter(pair.first, pair.second, minElems, maxElems);
+}
+
+//
+// Scaling
+//
+
+struct ScalingOptions
+{
+    size_t maxThreads{std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+    size_t numElems{size_t(1) << 20}; // Per thread
+    std::chrono::milliseconds duration{250};
+    int firstCore{-1};                // Thread i is pinned to firstCore + i
+};
+
+struct ConcurrentRun
+{
+    size_t calls; // Across all threads
+    double callsPerSec;
+};
+
+// Calls from every thread at once for the duration, each thread with the
+// call makeCall() gives it.
+template <typename MakeCall>
+static ConcurrentRun runConcurrently(const ScalingOptions& options, size_t numThreads, MakeCall makeCall)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<size_t> numReady{0};
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    std::vector<size_t> calls(numThreads, 0);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back(
+            [&, i]()
+            {
+                if (options.firstCore >= 0) TestUtility::pinThreadToCore((size_t(options.firstCore) + i) % std::thread::hardware_concurrency());
+
+                // Buffers are allocated and touched before the clock starts.
+                auto call = makeCall();
+                call();
+
+                ++numReady;
+                while (!started) std::this_thread::yield();
+
+                size_t numCalls = 0;
+                for (; !stopped; ++numCalls) call();
+                calls[i] = numCalls;
+            });
+    }
+
+    while (numReady < numThreads) std::this_thread::yield();
+
+    const auto start = Clock::now();
+    started = true;
+    std::this_thread::sleep_for(options.duration);
+    stopped = true;
+
+    for (auto& thread: threads) thread.join();
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    size_t totalCalls = 0;
+    for (const size_t numCalls: calls) totalCalls += numCalls;
+
+    return ConcurrentRun{totalCalls, totalCalls / elapsed.count()};
+}
+
+// Thread counts in powers of two, then the maximum
+static std::vector<size_t> getThreadCounts(size_t maxThreads)
+{
+    std::vector<size_t> counts;
+    for (size_t count = 1; count < maxThreads; count *= 2) counts.push_back(count);
+    counts.push_back(maxThreads);
+
+    return counts;
+}
+
+// Efficiency compares the bytes each conversion reads and writes to the bytes
+// memcpy reads and writes per second on buffers of the same total size, with
+// as many threads. Near 100%, the conversion is as memory-bound as a copy.
+static void scaleConverter(
+    const std::string& source,
+    const std::string& target,
+    const ScalingOptions& options)
+{
+    const size_t inBytes = options.numElems * SoapySDR::formatToSize(source);
+    const size_t outBytes = options.numElems * SoapySDR::formatToSize(target);
+    const size_t copyBytes = (inBytes + outBytes) / 2;
+    const double scalar = getScalar(source, target);
+
+    std::cout << std::endl << source << " -> " << target << " (" << options.numElems << " elements per thread)" << std::endl;
+
+    try
+    {
+        auto converterFunc = SoapySDR::ConverterRegistry::getFunction(source, target, SoapySDR::ConverterRegistry::VECTORIZED);
+
+        std::cout << std::setw(8) << "Threads" << std::setw(16) << "Total MS/s" << std::setw(16) << "Total GB/s"
+                  << std::setw(18) << "Per-thread GB/s" << std::setw(14) << "memcpy GB/s" << std::setw(12) << "Efficiency" << std::endl;
+
+        // Generated once, as threads copying it don't share the generator
+        const auto sharedInput = getInputBuffer(source, options.numElems);
+
+        for (const size_t numThreads: getThreadCounts(options.maxThreads))
+        {
+            const auto conversions = runConcurrently(
+                options,
+                numThreads,
+                [&]()
+                {
+                    auto input = std::make_shared<volk::vector<uint8_t>>(sharedInput);
+                    auto output = std::make_shared<volk::vector<uint8_t>>(outBytes);
+
+                    return [=]() { converterFunc(input->data(), output->data(), options.numElems, scalar); };
+                });
+            const auto copies = runConcurrently(
+                options,
+                numThreads,
+                [&]()
+                {
+                    auto input = std::make_shared<volk::vector<uint8_t>>(copyBytes, 1);
+                    auto output = std::make_shared<volk::vector<uint8_t>>(copyBytes);
+
+                    return [=]() { std::memcpy(output->data(), input->data(), copyBytes); };
+                });
+
+            const double callsPerSec = conversions.callsPerSec;
+            const double totalGBps = callsPerSec * (inBytes + outBytes) / 1e9;
+            const double memcpyGBps = copies.callsPerSec * (2 * copyBytes) / 1e9;
+
+            std::cout << std::setw(8) << numThreads
+                      << std::setw(16) << (callsPerSec * options.numElems / 1e6)
+                      << std::setw(16) << totalGBps
+                      << std::setw(18) << (totalGBps / numThreads)
+                      << std::setw(14) << memcpyGBps
+                      << std::setw(11) << (100.0 * totalGBps / memcpyGBps) << "%" << std::endl;
+
+            // Mean time per call, as each thread sees it
+            BenchmarkResults::Result result{
+                "scaling",
+                source,
+                target,
+                "vectorized",
+                options.numElems,
+                (1e6 * numThreads / callsPerSec),
+                0.0,
+                0.0,
+                conversions.calls,
+                getKernelDescription(source, target)};
+            result.threads = numThreads;
+            results.push_back(result);
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+    }
+}
+
+static void scaleAllConverters(const ScalingOptions& options)
+{
+    std::cout << std::endl << "Thread scaling (" << options.duration.count() << "ms per point):" << std::endl;
+
+    for (const auto& pair: listPairs()) scaleConverter(pair.first, pair.second, options);
+}
+
+//
+// Cold caches
+//
+
+struct ColdOptions
+{
+    size_t poolBytes{0}; // 0 for twice the last-level cache
+    double rateMSps{0.0}; // Pace calls at this sample rate, or 0 not to
+};
+
+// Input and output buffers laid out one after another, so a pool larger than
+// the last-level cache evicts each buffer before it's reused, as with buffers
+// arriving by DMA.
+class BufferPool
+{
+public:
+    BufferPool(volk::vector<uint8_t>& storage, const volk::vector<uint8_t>& input, size_t outBytes):
+        _storage(storage),
+        _inBytes(input.size()),
+        _slotBytes(roundUp(input.size()) + roundUp(outBytes)),
+        _numSlots(std::max<size_t>(storage.size() / _slotBytes, 1))
+    {
+        if (_storage.size() < _slotBytes) _storage.resize(_slotBytes);
+        for (size_t i = 0; i < _numSlots; ++i) std::memcpy(getInput(i), input.data(), _inBytes);
+    }
+
+    size_t size() const { return _numSlots; }
+
+    uint8_t* getInput(size_t slot) { return _storage.data() + ((slot % _numSlots) * _slotBytes); }
+    uint8_t* getOutput(size_t slot) { return getInput(slot) + roundUp(_inBytes); }
+
+private:
+    static size_t roundUp(size_t bytes)
+    {
+        const size_t alignment = volk_get_alignment();
+        return ((bytes + alignment - 1) / alignment) * alignment;
+    }
+
+    volk::vector<uint8_t>& _storage;
+    size_t _inBytes;
+    size_t _slotBytes;
+    size_t _numSlots;
+};
+
+// Each buffer is due a period after the last, and a call's latency runs from
+// when its buffer is due to when it returns, so it includes waiting for
+// earlier calls that ran late.
+static void benchmarkPaced(
+    const SoapySDR::ConverterRegistry::ConverterFunction converterFunc,
+    BufferPool& pool,
+    double scalar,
+    double rateMSps,
+    const std::string& source,
+    const std::string& target)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::micro>(numElements / rateMSps));
+    const size_t numCalls = std::max<size_t>(
+        timing.minIterations,
+        size_t(std::chrono::duration<double>(timing.maxTime) / std::chrono::duration<double>(period)));
+
+    volk::vector<double> latenciesUs(numCalls);
+    size_t numLate = 0;
+
+    const auto start = Clock::now();
+    for (size_t i = 0; i < numCalls; ++i)
+    {
+        const auto due = start + (period * i);
+        while (Clock::now() < due) {}
+
+        converterFunc(pool.getInput(i), pool.getOutput(i), numElements, scalar);
+
+        const std::chrono::duration<double, std::micro> latency = Clock::now() - due;
+        latenciesUs[i] = latency.count();
+        if (latency > period) ++numLate;
+    }
+
+    const std::chrono::duration<double, std::micro> periodUs = period;
+    std::cout << "Paced:   " << rateMSps << " MS/s, a buffer every " << periodUs.count() << "us" << std::endl;
+    std::cout << "Latency: p50 " << TestUtility::percentile(latenciesUs, 0.5) << "us, p99 "
+              << TestUtility::percentile(latenciesUs, 0.99) << "us, max "
+              << *std::max_element(latenciesUs.begin(), latenciesUs.end()) << "us" << std::endl;
+    std::cout << "Late:    " << numLate << " of " << numCalls << " buffers took longer than the period" << std::endl;
+
+    results.push_back(BenchmarkResults::Result{
+        "paced",
+        source,
+        target,
+        "vectorized",
+        numElements,
+        TestUtility::median(latenciesUs),
+        TestUtility::medAbsDev(latenciesUs),
+        0.0,
+        numCalls,
+        getKernelDescription(source, target)});
+}
+
+static void benchmarkCold(
+    const std::string& source,
+    const std::string& target,
+    volk::vector<uint8_t>& storage,
+    const ColdOptions& options)
+{
+    const size_t outBytes = numElements * SoapySDR::formatToSize(target);
+    const double scalar = getScalar(source, target);
+
+    try
+    {
+        auto converterFunc = SoapySDR::ConverterRegistry::getFunction(source, target, SoapySDR::ConverterRegistry::VECTORIZED);
+
+        BufferPool pool(storage, getInputBuffer(source, numElements), outBytes);
+
+        std::cout << std::endl << source << " -> " << target << " (" << pool.size() << " buffers)" << std::endl;
+
+        const auto hot = measure(
+            [&]()
+            {
+                converterFunc(pool.getInput(0), pool.getOutput(0), numElements, scalar);
+            },
+            numElements,
+            numElements * SoapySDR::formatToSize(source) + outBytes);
+
+        size_t slot = 0;
+        const auto cold = measure(
+            [&]()
+            {
+                converterFunc(pool.getInput(slot), pool.getOutput(slot), numElements, scalar);
+                ++slot;
+            },
+            numElements,
+            numElements * SoapySDR::formatToSize(source) + outBytes);
+        recordResult("cold", source, target, SoapySDR::ConverterRegistry::VECTORIZED, numElements, cold);
+
+        printMeasurement("Hot:     ", hot);
+        printMeasurement("Cold:    ", cold);
+        std::cout << (cold.medianUs / hot.medianUs) << "x slower cold" << std::endl;
+
+        if (options.rateMSps > 0.0) benchmarkPaced(converterFunc, pool, scalar, options.rateMSps, source, target);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+    }
+}
+
+static void benchmarkAllCold(const ColdOptions& options)
+{
+    static constexpr size_t defaultPoolBytes = size_t(64) << 20;
+
+    const size_t cacheBytes = TestUtility::getLastLevelCacheBytes();
+    const size_t poolBytes = (options.poolBytes > 0) ? options.poolBytes : ((cacheBytes > 0) ? (2 * cacheBytes) : defaultPoolBytes);
+
+    std::cout << std::endl << "Cold caches (" << numElements << " elements, rotating through " << (poolBytes >> 20) << " MB";
+    if (cacheBytes > 0) std::cout << ", last-level cache " << (cacheBytes >> 20) << " MB";
+    std::cout << "):" << std::endl;
+
+    // Shared by every pair, so it's only allocated once
+    volk::vector<uint8_t> storage(poolBytes);
+
+    for (const auto& pair: listPairs()) benchmarkCold(pair.first, pair.second, storage, options);
+}
+
+//
+// Alignment
+//
+
+struct AlignmentOptions
+{
+    size_t offsetStep{8};    // Bytes between misalignments, from 0 to 63
+    size_t remainderStep{1}; // Elements between length remainders, from 0 to 63
+};
+
+static constexpr size_t maxMisalignment = 64;
+
+static std::string formatSlowdown(double slowdown)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << slowdown;
+
+    return out.str();
+}
+
+// Slowdowns are relative to aligned buffers of numElements, which are a
+// multiple of every SIMD width, so they only take the aligned kernels' fast
+// path. Lengths are compared per element.
+static void benchmarkAlignment(
+    const std::string& source,
+    const std::string& target,
+    const AlignmentOptions& options)
+{
+    const size_t inSize = SoapySDR::formatToSize(source);
+    const size_t outSize = SoapySDR::formatToSize(target);
+    const double scalar = getScalar(source, target);
+
+    std::cout << std::endl << source << " -> " << target << std::endl;
+
+    try
+    {
+        auto converterFunc = SoapySDR::ConverterRegistry::getFunction(source, target, SoapySDR::ConverterRegistry::VECTORIZED);
+
+        // Room for the largest offset and remainder
+        const size_t maxElems = numElements + maxMisalignment;
+        const auto input = getInputBuffer(source, maxElems + maxMisalignment);
+        volk::vector<uint8_t> output((maxElems + maxMisalignment) * outSize);
+
+        auto measureAt = [&](size_t srcOffset, size_t dstOffset, size_t numElems)
+        {
+            const uint8_t* in = input.data() + srcOffset;
+            uint8_t* out = output.data() + dstOffset;
+
+            return measure(
+                [&]() { converterFunc(in, out, numElems, scalar); },
+                numElems,
+                numElems * (inSize + outSize));
+        };
+
+        const auto aligned = measureAt(0, 0, numElements);
+        printMeasurement("Aligned: ", aligned);
+
+        std::vector<size_t> offsets;
+        for (size_t offset = 0; offset < maxMisalignment; offset += options.offsetStep) offsets.push_back(offset);
+        if (offsets.back() != (maxMisalignment - 1)) offsets.push_back(maxMisalignment - 1);
+
+        std::cout << "Slowdown by source (rows) and destination (columns) offset in bytes:" << std::endl;
+        std::cout << std::setw(6) << "";
+        for (const size_t dstOffset: offsets) std::cout << std::setw(6) << dstOffset;
+        std::cout << std::endl;
+
+        for (const size_t srcOffset: offsets)
+        {
+            std::cout << std::setw(6) << srcOffset;
+            for (const size_t dstOffset: offsets)
+            {
+                const auto measurement = measureAt(srcOffset, dstOffset, numElements);
+                std::cout << std::setw(6) << formatSlowdown(measurement.medianUs / aligned.medianUs) << std::flush;
+
+                recordResult(
+                    "misaligned_" + std::to_string(srcOffset) + "_" + std::to_string(dstOffset),
+                    source,
+                    target,
+                    SoapySDR::ConverterRegistry::VECTORIZED,
+                    numElements,
+                    measurement);
+            }
+            std::cout << std::endl;
+        }
+
+        std::cout << "Slowdown per element by elements past " << numElements << ", aligned:" << std::endl;
+
+        size_t column = 0;
+        for (size_t remainder = 0; remainder < maxMisalignment; remainder += options.remainderStep)
+        {
+            const size_t numElems = numElements + remainder;
+            const auto measurement = measureAt(0, 0, numElems);
+            const double slowdown = (measurement.medianUs / numElems) / (aligned.medianUs / numElements);
+
+            std::cout << std::setw(4) << ("+" + std::to_string(remainder)) << std::setw(6) << formatSlowdown(slowdown)
+                      << (((++column % 8) == 0) ? "\n" : "  ") << std::flush;
+
+            recordResult("remainder", source, target, SoapySDR::ConverterRegistry::VECTORIZED, numElems, measurement);
+        }
+        if ((column % 8) != 0) std::cout << std::endl;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+    }
+}
+
+static void benchmarkAllAlignments(const AlignmentOptions& options)
+{
+    std::cout << std::endl << "Alignment and length (median per call):" << std::endl;
+
+    for (const auto& pair: listPairs()) benchmarkAlignment(pair.first, pair.second, options);
+}
+
+//
+// Tail latency
+//
+
+struct TailOptions
+{
+    size_t calls{20000};      // Enough for a p99.9 of 20 calls
+    size_t numCoRunners{2};
+    size_t coRunnerBytes{0};  // Each, or 0 for the last-level cache's size
+    int firstCore{-1};        // Co-runners are pinned to the cores after it
+};
+
+// Threads interfering with the converter the way FFTs and disk I/O on other
+// cores do: even ones stream copies through memory, consuming bandwidth,
+// and odd ones update random cache lines, evicting the converter's from the
+// shared last-level cache. Constructed once every co-runner has allocated
+// its buffers and entered its loop.
+class CoRunners
+{
+public:
+    CoRunners(const TailOptions& options):
+        _numReady(0),
+        _stopped(false)
+    {
+        for (size_t i = 0; i < options.numCoRunners; ++i)
+        {
+            _threads.emplace_back(
+                [this, &options, i]()
+                {
+                    if (options.firstCore >= 0) TestUtility::pinThreadToCore((size_t(options.firstCore) + i + 1) % std::thread::hardware_concurrency());
+
+                    if ((i % 2) == 0) streamCopies(options.coRunnerBytes);
+                    else updateRandomLines(options.coRunnerBytes);
+                });
+        }
+
+        while (_numReady < options.numCoRunners) std::this_thread::yield();
+    }
+
+    ~CoRunners()
+    {
+        _stopped = true;
+        for (auto& thread: _threads) thread.join();
+    }
+
+private:
+    void streamCopies(size_t numBytes)
+    {
+        volk::vector<uint8_t> source(numBytes / 2, 1);
+        volk::vector<uint8_t> destination(numBytes / 2);
+
+        ++_numReady;
+        while (!_stopped) std::memcpy(destination.data(), source.data(), source.size());
+    }
+
+    void updateRandomLines(size_t numBytes)
+    {
+        static constexpr size_t lineBytes = 64;
+
+        volk::vector<uint8_t> lines(numBytes);
+        const size_t numLines = lines.size() / lineBytes;
+
+        // xorshift, as cheap as possible so the updates dominate
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+
+        ++_numReady;
+        while (!_stopped)
+        {
+            for (size_t i = 0; i < 1024; ++i)
+            {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                ++lines[(state % numLines) * lineBytes];
+            }
+        }
+    }
+
+    std::atomic<size_t> _numReady;
+    std::atomic<bool> _stopped;
+    std::vector<std::thread> _threads;
+};
+
+struct TailLatency
+{
+    double p50Us;
+    double p99Us;
+    double p999Us;
+    double maxUs;
+    double medAbsDevUs;
+};
+
+static TailLatency measureTail(
+    const SoapySDR::ConverterRegistry::ConverterFunction converterFunc,
+    const volk::vector<uint8_t>& input,
+    volk::vector<uint8_t>& output,
+    double scalar,
+    size_t numCalls)
+{
+    using SoapyVOLKConverters::readCycleCounter;
+
+    // Warms caches and branch predictors, as measure() does
+    const auto warmupEnd = std::chrono::steady_clock::now() + timing.warmup;
+    do converterFunc(input.data(), output.data(), numElements, scalar); while (std::chrono::steady_clock::now() < warmupEnd);
+
+    volk::vector<double> latenciesUs(numCalls);
+    for (auto& latencyUs: latenciesUs)
+    {
+        const uint64_t startTicks = readCycleCounter();
+        converterFunc(input.data(), output.data(), numElements, scalar);
+        latencyUs = (readCycleCounter() - startTicks) / ticksPerNs / 1e3;
+    }
+
+    return TailLatency{
+        TestUtility::percentile(latenciesUs, 0.5),
+        TestUtility::percentile(latenciesUs, 0.99),
+        TestUtility::percentile(latenciesUs, 0.999),
+        *std::max_element(latenciesUs.begin(), latenciesUs.end()),
+        TestUtility::medAbsDev(latenciesUs)};
+}
+
+static void printTail(const std::string& label, const TailLatency& latency)
+{
+    std::cout << std::setw(10) << label << std::setw(12) << latency.p50Us << std::setw(12) << latency.p99Us
+              << std::setw(12) << latency.p999Us << std::setw(12) << latency.maxUs << std::endl;
+}
+
+static void recordTail(
+    const std::string& mode,
+    const std::string& source,
+    const std::string& target,
+    const TailLatency& latency,
+    size_t numCalls)
+{
+    BenchmarkResults::Result result{
+        mode,
+        source,
+        target,
+        "vectorized",
+        numElements,
+        latency.p50Us,
+        latency.medAbsDevUs,
+        0.0,
+        numCalls,
+        getKernelDescription(source, target)};
+    result.p99Us = latency.p99Us;
+    result.p999Us = latency.p999Us;
+    result.maxUs = latency.maxUs;
+    results.push_back(result);
+}
+
+// Quiet first, then with co-runners, which only run while measured.
+static void benchmarkTail(
+    const std::string& source,
+    const std::string& target,
+    const TailOptions& options)
+{
+    const double scalar = getScalar(source, target);
+
+    std::cout << std::endl << source << " -> " << target << std::endl;
+
+    try
+    {
+        auto converterFunc = SoapySDR::ConverterRegistry::getFunction(source, target, SoapySDR::ConverterRegistry::VECTORIZED);
+
+        const auto input = getInputBuffer(source, numElements);
+        volk::vector<uint8_t> output(numElements * SoapySDR::formatToSize(target));
+
+        std::cout << std::setw(10) << "" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us"
+                  << std::setw(12) << "p99.9 us" << std::setw(12) << "max us" << std::endl;
+
+        const auto quiet = measureTail(converterFunc, input, output, scalar, options.calls);
+        printTail("Quiet", quiet);
+        recordTail("tail_quiet", source, target, quiet, options.calls);
+
+        if (options.numCoRunners == 0) return;
+
+        TailLatency loaded;
+        {
+            const CoRunners coRunners(options);
+            loaded = measureTail(converterFunc, input, output, scalar, options.calls);
+        }
+        printTail("Loaded", loaded);
+        recordTail("tail_loaded", source, target, loaded, options.calls);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+    }
+}
+
+static void benchmarkAllTails(TailOptions options)
+{
+    static constexpr size_t defaultCoRunnerBytes = size_t(64) << 20;
+
+    if (options.coRunnerBytes == 0)
+    {
+        const size_t cacheBytes = TestUtility::getLastLevelCacheBytes();
+        options.coRunnerBytes = (cacheBytes > 0) ? cacheBytes : defaultCoRunnerBytes;
+    }
+
+    std::cout << std::endl << "Tail latency (" << numElements << " elements, " << options.calls << " calls, "
+              << options.numCoRunners << " co-runners over " << (options.coRunnerBytes >> 20) << " MB each):" << std::endl;
+
+    if (options.numCoRunners >= std::thread::hardware_concurrency())
+    {
+        std::cerr << "Co-runners share the converter's core, with " << std::thread::hardware_concurrency() << " core(s) for "
+                  << (options.numCoRunners + 1) << " threads" << std::endl;
+    }
+
+    for (const auto& pair: listPairs()) benchmarkTail(pair.first, pair.second, options);
+}
+
+//
+// A/B
+//
+
+struct PairedMeasurement
+{
+    Measurement a;
+    Measurement b;
+
+    // How many times faster B is than A: the median of each iteration's
+    // ratio, with its 95% confidence interval
+    double speedup;
+    double speedupLower;
+    double speedupUpper;
+};
+
+// Times A and B back to back each iteration, alternating which goes first,
+// so drift in clock speed or temperature affects both alike.
+template <typename CallA, typename CallB>
+static PairedMeasurement measurePaired(CallA callA, CallB callB, size_t numElems)
+{
+    using Clock = std::chrono::steady_clock;
+    using SoapyVOLKConverters::readCycleCounter;
+
+    const auto warmupEnd = Clock::now() + timing.warmup;
+    do { callA(); callB(); } while (Clock::now() < warmupEnd);
+
+    const size_t maxIterations = (timing.iterations > 0) ? timing.iterations : timing.maxIterations;
+    const auto deadline = Clock::now() + timing.maxTime;
+
+    std::vector<uint64_t> ticksA;
+    std::vector<uint64_t> ticksB;
+    std::vector<double> speedups;
+
+    size_t nextCheck = std::max<size_t>(timing.minIterations, 1);
+    while (speedups.size() < maxIterations)
+    {
+        const bool aFirst = ((speedups.size() % 2) == 0);
+        uint64_t a = 0;
+        uint64_t b = 0;
+        for (size_t i = 0; i < 2; ++i)
+        {
+            const bool runA = ((i == 0) == aFirst);
+            const uint64_t startTicks = readCycleCounter();
+            if (runA) callA();
+            else callB();
+            (runA ? a : b) = readCycleCounter() - startTicks;
+        }
+        ticksA.push_back(a);
+        ticksB.push_back(b);
+        speedups.push_back(double(a) / double(std::max<uint64_t>(b, 1)));
+
+        if ((timing.iterations > 0) || (speedups.size() < nextCheck)) continue;
+        nextCheck = speedups.size() + (speedups.size() / 4) + 1;
+
+        auto sorted = speedups;
+        const auto ci = getMedianCI(sorted);
+        const double median = sorted[sorted.size() / 2];
+        if ((((ci.second - ci.first) / 2.0) <= (median * timing.targetCIPercent / 100.0)) || (Clock::now() >= deadline)) break;
+    }
+
+    PairedMeasurement measurement;
+    measurement.a = summarize(ticksA, numElems);
+    measurement.b = summarize(ticksB, numElems);
+
+    const auto ci = getMedianCI(speedups);
+    measurement.speedup = speedups[speedups.size() / 2];
+    measurement.speedupLower = ci.first;
+    measurement.speedupUpper = ci.second;
+
+    return measurement;
+}
+
+static SoapySDR::ConverterRegistry::ConverterFunction getModuleConverter(
+    const std::string& modulePath,
+    const std::string& source,
+    const std::string& target)
+{
+    auto getConverter = GET_MODULE_FUNCTION_FROM(modulePath, SoapyVOLKConverters_getConverter);
+    return getConverter(source.c_str(), target.c_str(), SoapySDR::ConverterRegistry::VECTORIZED);
+}
+
+static void compareModules(
+    const std::string& source,
+    const std::string& target,
+    const std::string& modulePathB)
+{
+    const double scalar = getScalar(source, target);
+
+    std::cout << std::endl << source << " -> " << target << std::endl;
+
+    try
+    {
+        // Builds from before SoapyVOLKConverters_getConverter can still be A,
+        // as SoapySDR keeps A's converters.
+        auto converterA = SoapySDR::ConverterRegistry::getFunction(source, target, SoapySDR::ConverterRegistry::VECTORIZED);
+        auto converterB = getModuleConverter(modulePathB, source, target);
+        if (!converterB)
+        {
+            std::cout << "Not in B" << std::endl;
+            return;
+        }
+
+        const auto input = getInputBuffer(source, numElements);
+        volk::vector<uint8_t> outputA(numElements * SoapySDR::formatToSize(target));
+        volk::vector<uint8_t> outputB(outputA.size());
+
+        const auto measurement = measurePaired(
+            [&]() { converterA(input.data(), outputA.data(), numElements, scalar); },
+            [&]() { converterB(input.data(), outputB.data(), numElements, scalar); },
+            numElements);
+        recordResult("ab_a", source, target, SoapySDR::ConverterRegistry::VECTORIZED, numElements, measurement.a);
+        recordResult("ab_b", source, target, SoapySDR::ConverterRegistry::VECTORIZED, numElements, measurement.b);
+
+        printMeasurement("A: ", measurement.a);
+        printMeasurement("B: ", measurement.b);
+        std::cout << "B is " << measurement.speedup << "x as fast as A (95% CI " << measurement.speedupLower
+                  << "x to " << measurement.speedupUpper << "x)" << std::endl;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+    }
+}
+
+static void compareAllModules(const std::string& modulePathB)
+{
+    std::cout << std::endl << "A/B comparison (interleaved per call):" << std::endl;
+    std::cout << " * A: " << ModuleLoader::getModulePath() << " (" << SoapySDR::getModuleVersion(ModuleLoader::getModulePath()) << ")" << std::endl;
+    std::cout << " * B: " << modulePathB << " (" << SoapySDR::getModuleVersion(modulePathB) << ")" << std::endl;
+
+    for (const auto& pair: listPairs()) compareModules(pair.first, pair.second, modulePathB);
+}
+
+//
+// Statistics overhead
+//
+
+// Statistics should cost under 1% at this size, a typical radio buffer.
+static constexpr size_t StatsOverheadElems = 4096;
+static constexpr double StatsOverheadTargetPercent = 1.0;
+
+// Returns the overhead in percent.
+static double benchmarkStatsOverhead(
+    const std::string& source,
+    const std::string& target)
+{
+    const double scalar = getScalar(source, target);
+
+    std::cout << std::endl << source << " -> " << target << std::endl;
+
+    auto setEnabled = GET_MODULE_FUNCTION(SoapyVOLKConverters_setStatsEnabled);
+    auto converterFunc = SoapySDR::ConverterRegistry::getFunction(source, target, SoapySDR::ConverterRegistry::VECTORIZED);
+
+    const auto input = getInputBuffer(source, StatsOverheadElems);
+    volk::vector<uint8_t> output(StatsOverheadElems * SoapySDR::formatToSize(target));
+
+    // Setting the flag is one relaxed store, timed in both.
+    const auto measurement = measurePaired(
+        [&]() { setEnabled(false); converterFunc(input.data(), output.data(), StatsOverheadElems, scalar); },
+        [&]() { setEnabled(true); converterFunc(input.data(), output.data(), StatsOverheadElems, scalar); },
+        StatsOverheadElems);
+    setEnabled(false);
+
+    recordResult("stats_off", source, target, SoapySDR::ConverterRegistry::VECTORIZED, StatsOverheadElems, measurement.a);
+    recordResult("stats_on", source, target, SoapySDR::ConverterRegistry::VECTORIZED, StatsOverheadElems, measurement.b);
+
+    // Speedup is off over on, so overhead is its inverse.
+    const double overhead = 100.0 * ((1.0 / measurement.speedup) - 1.0);
+    printMeasurement("Off: ", measurement.a);
+    printMeasurement("On:  ", measurement.b);
+    std::cout << "Overhead: " << overhead << "% (95% CI " << (100.0 * ((1.0 / measurement.speedupUpper) - 1.0))
+              << "% to " << (100.0 * ((1.0 / measurement.speedupLower) - 1.0)) << "%)" << std::endl;
+
+    return overhead;
+}
+
+static void benchmarkAllStatsOverhead()
+{
+    std::cout << std::endl << "Statistics overhead (" << StatsOverheadElems << " elements, interleaved per call):" << std::endl;
+
+    // Judging against 1% needs a much tighter interval than the default.
+    const auto defaultTiming = timing;
+    timing.targetCIPercent = std::min(timing.targetCIPercent, 0.1);
+    timing.maxTime = std::max(timing.maxTime, std::chrono::milliseconds(10000));
+
+    std::vector<double> overheads;
+    for (const auto& pair: listPairs())
+    {
+        try
+        {
+            overheads.push_back(benchmarkStatsOverhead(pair.first, pair.second));
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+        }
+    }
+    timing = defaultTiming;
+    if (overheads.empty()) return;
+
+    std::sort(overheads.begin(), overheads.end());
+    const size_t numOver = size_t(std::count_if(overheads.begin(), overheads.end(), [](double overhead) { return overhead > StatsOverheadTargetPercent; }));
+
+    std::cout << std::endl << "Median overhead " << overheads[overheads.size() / 2] << "%, max " << overheads.back() << "%, "
+              << numOver << " of " << overheads.size() << " pairs over " << StatsOverheadTargetPercent << "%" << std::endl;
+}
+
+//
+// Implementations
+//
+
+// Calls one implementation through VOLK's _manual entry point.
+using ManualCall = void(*)(void* output, const void* input, float scalar, unsigned int numElems, const char* impl);
+
+struct ManualKernel
+{
+    const char* name;
+    volk_func_desc_t (*getFuncDesc)(void);
+    const char* inFormat;
+    const char* outFormat;
+    float scalar;
+    ManualCall call;
+};
+
+// Every kernel a converter calls. Hand-written, as each _manual entry point
+// takes its own argument types, so kernels the module lists without an entry
+// here are reported and skipped.
+static const ManualKernel ManualKernels[] =
+{
+    {"volk_8i_convert_16i", &volk_8i_convert_16i_get_func_desc, SOAPY_SDR_S8, SOAPY_SDR_S16, 1.0f,
+     [](void* output, const void* input, float, unsigned int numElems, const char* impl)
+     {
+         volk_8i_convert_16i_manual((int16_t*)output, (const int8_t*)input, numElems, impl);
+     }},
+    {"volk_16i_convert_8i", &volk_16i_convert_8i_get_func_desc, SOAPY_SDR_S16, SOAPY_SDR_S8, 1.0f,
+     [](void* output, const void* input, float, unsigned int numElems, const char* impl)
+     {
+         volk_16i_convert_8i_manual((int8_t*)output, (const int16_t*)input, numElems, impl);
+     }},
+    {"volk_8i_s32f_convert_32f", &volk_8i_s32f_convert_32f_get_func_desc, SOAPY_SDR_S8, SOAPY_SDR_F32, float(TestUtility::S8FullScale),
+     [](void* output, const void* input, float scalar, unsigned int numElems, const char* impl)
+     {
+         volk_8i_s32f_convert_32f_manual((float*)output, (const int8_t*)input, scalar, numElems, impl);
+     }},
+    {"volk_16i_s32f_convert_32f", &volk_16i_s32f_convert_32f_get_func_desc, SOAPY_SDR_S16, SOAPY_SDR_F32, float(TestUtility::S16FullScale),
+     [](void* output, const void* input, float scalar, unsigned int numElems, const char* impl)
+     {
+         volk_16i_s32f_convert_32f_manual((float*)output, (const int16_t*)input, scalar, numElems, impl);
+     }},
+    {"volk_32i_s32f_convert_32f", &volk_32i_s32f_convert_32f_get_func_desc, SOAPY_SDR_S32, SOAPY_SDR_F32, float(TestUtility::S32FullScale),
+     [](void* output, const void* input, float scalar, unsigned int numElems, const char* impl)
+     {
+         volk_32i_s32f_convert_32f_manual((float*)output, (const int32_t*)input, scalar, numElems, impl);
+     }},
+    {"volk_32f_s32f_convert_8i", &volk_32f_s32f_convert_8i_get_func_desc, SOAPY_SDR_F32, SOAPY_SDR_S8, float(TestUtility::F32ToS8Scalar),
+     [](void* output, const void* input, float scalar, unsigned int numElems, const char* impl)
+     {
+         volk_32f_s32f_convert_8i_manual((int8_t*)output, (const float*)input, scalar, numElems, impl);
+     }},
+    {"volk_32f_s32f_convert_16i", &volk_32f_s32f_convert_16i_get_func_desc, SOAPY_SDR_F32, SOAPY_SDR_S16, float(TestUtility::F32ToS16Scalar),
+     [](void* output, const void* input, float scalar, unsigned int numElems, const char* impl)
+     {
+         volk_32f_s32f_convert_16i_manual((int16_t*)output, (const float*)input, scalar, numElems, impl);
+     }},
+    {"volk_32f_s32f_convert_32i", &volk_32f_s32f_convert_32i_get_func_desc, SOAPY_SDR_F32, SOAPY_SDR_S32, float(TestUtility::F32ToS32Scalar),
+     [](void* output, const void* input, float scalar, unsigned int numElems, const char* impl)
+     {
+         volk_32f_s32f_convert_32i_manual((int32_t*)output, (const float*)input, scalar, numElems, impl);
+     }},
+    {"volk_32f_s32f_multiply_32f", &volk_32f_s32f_multiply_32f_get_func_desc, SOAPY_SDR_F32, SOAPY_SDR_F32, 10.0f,
+     [](void* output, const void* input, float scalar, unsigned int numElems, const char* impl)
+     {
+         volk_32f_s32f_multiply_32f_manual((float*)output, (const float*)input, scalar, numElems, impl);
+     }},
+    {"volk_32f_convert_64f", &volk_32f_convert_64f_get_func_desc, SOAPY_SDR_F32, SOAPY_SDR_F64, 1.0f,
+     [](void* output, const void* input, float, unsigned int numElems, const char* impl)
+     {
+         volk_32f_convert_64f_manual((double*)output, (const float*)input, numElems, impl);
+     }},
+    {"volk_64f_convert_32f", &volk_64f_convert_32f_get_func_desc, SOAPY_SDR_F64, SOAPY_SDR_F32, 1.0f,
+     [](void* output, const void* input, float, unsigned int numElems, const char* impl)
+     {
+         volk_64f_convert_32f_manual((float*)output, (const double*)input, numElems, impl);
+     }},
+};
+
+struct ImplTiming
+{
+    std::string impl;
+    Measurement measurement;
+};
+
+// Fastest first, marking the implementation VOLK dispatches to. Returns the
+// fastest.
+static std::string printRanking(
+    const std::string& label,
+    std::vector<ImplTiming>& timings,
+    const std::string& dispatched)
+{
+    std::sort(
+        timings.begin(),
+        timings.end(),
+        [](const ImplTiming& a, const ImplTiming& b) { return (a.measurement.medianUs < b.measurement.medianUs); });
+
+    std::cout << "  " << label << ":" << std::endl;
+    for (size_t i = 0; i < timings.size(); ++i)
+    {
+        const auto& timing = timings[i];
+        std::cout << "    " << (i + 1) << ". " << std::left << std::setw(16) << timing.impl << std::right
+                  << std::setw(10) << timing.measurement.medianUs << "us  "
+                  << std::setw(6) << (timing.measurement.medianUs / timings[0].measurement.medianUs) << "x"
+                  << ((timing.impl == dispatched) ? "  (dispatched)" : "") << std::endl;
+    }
+
+    return timings.empty() ? "" : timings[0].impl;
+}
+
+// Times every implementation VOLK has for a kernel on this host, with
+// aligned buffers, then with buffers offset by one element. Aligned
+// implementations only take aligned buffers.
+static void benchmarkImpls(
+    const ManualKernel& kernel,
+    const SoapyVOLKConvertersKernelInfo& info)
+{
+    const auto desc = kernel.getFuncDesc();
+    const size_t inSize = SoapySDR::formatToSize(kernel.inFormat);
+    const size_t outSize = SoapySDR::formatToSize(kernel.outFormat);
+
+    // One extra element for the unaligned offset
+    const auto input = getInputBuffer(kernel.inFormat, numElements + 1);
+    volk::vector<uint8_t> output((numElements + 1) * outSize);
+
+    std::cout << std::endl << kernel.name << " (dispatches " << info.alignedImpl << "/" << info.unalignedImpl
+              << ", " << info.selectedBy << ")" << std::endl;
+
+    std::vector<ImplTiming> alignedTimings;
+    std::vector<ImplTiming> unalignedTimings;
+    for (size_t i = 0; i < desc.n_impls; ++i)
+    {
+        const char* impl = desc.impl_names[i];
+
+        for (const bool aligned: {true, false})
+        {
+            if (desc.impl_alignment[i] && !aligned) continue;
+
+            const uint8_t* in = input.data() + (aligned ? 0 : inSize);
+            uint8_t* out = output.data() + (aligned ? 0 : outSize);
+
+            const auto measurement = measure(
+                [&]()
+                {
+                    kernel.call(out, in, kernel.scalar, (unsigned int)numElements, impl);
+                },
+                numElements,
+                numElements * (inSize + outSize));
+
+            results.push_back(BenchmarkResults::Result{
+                "impls",
+                kernel.name,
+                impl,
+                (aligned ? "aligned" : "unaligned"),
+                numElements,
+                measurement.medianUs,
+                measurement.medAbsDevUs,
+                measurement.cyclesPerElem,
+                measurement.iterations,
+                ""});
+
+            (aligned ? alignedTimings : unalignedTimings).push_back(ImplTiming{impl, measurement});
+        }
+    }
+
+    const auto fastestAligned = printRanking("Aligned buffers", alignedTimings, info.alignedImpl);
+    const auto fastestUnaligned = printRanking("Unaligned buffers", unalignedTimings, info.unalignedImpl);
+
+    // In the format of volk_profile's config file
+    if ((fastestAligned != info.alignedImpl) || (fastestUnaligned != info.unalignedImpl))
+    {
+        std::cout << "  Fastest here differs from dispatch. volk_config line:" << std::endl
+                  << "    " << kernel.name << " " << fastestAligned << " " << fastestUnaligned << std::endl;
+    }
+}
+
+static void benchmarkAllImpls()
+{
+    auto getKernelInfo = GET_MODULE_FUNCTION(SoapyVOLKConverters_getKernelInfo);
+
+    std::vector<SoapyVOLKConvertersKernelInfo> allInfo(getKernelInfo(nullptr, 0));
+    getKernelInfo(allInfo.data(), allInfo.size());
+
+    std::cout << std::endl << "VOLK implementations (median per call, " << numElements << " elements):" << std::endl;
+
+    for (const auto& kernel: ManualKernels)
+    {
+        const auto infoIter = std::find_if(
+            allInfo.begin(),
+            allInfo.end(),
+            [&kernel](const SoapyVOLKConvertersKernelInfo& info) { return (std::strcmp(info.kernel, kernel.name) == 0); });
+        if (infoIter == allInfo.end()) continue;
+
+        try
+        {
+            benchmarkImpls(kernel, *infoIter);
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+        }
+    }
+
+    std::vector<std::string> missingKernels;
+    for (const auto& info: allInfo)
+    {
+        if (!info.kernel[0] || (std::find(missingKernels.begin(), missingKernels.end(), info.kernel) != missingKernels.end())) continue;
+
+        const auto kernelIter = std::find_if(
+            std::begin(ManualKernels),
+            std::end(ManualKernels),
+            [&info](const ManualKernel& kernel) { return (std::strcmp(info.kernel, kernel.name) == 0); });
+        if (kernelIter == std::end(ManualKernels)) missingKernels.push_back(info.kernel);
+    }
+    for (const auto& kernel: missingKernels) std::cerr << "No _manual call for " << kernel << ", skipped" << std::endl;
+}
+
+//
+// Startup
+//
+
+// Processes that convert briefly, like command-line tools, pay for loading
+// the module and the first call more than for conversion itself. The module
+// only loads once per process, so each run is a fresh child process, running
+// BenchmarkSoapyVOLKStartup, which doesn't link VOLK.
+struct StartupOptions
+{
+    size_t runs{20};
+};
+
+// The module's and VOLK's load-time options, one set per configuration in
+// the child's environment
+struct StartupConfig
+{
+    const char* name;
+    const char* variable; // nullptr for none
+    const char* value;
+    bool valueIsFile; // Removed afterwards
+};
+
+static const std::vector<StartupConfig> StartupConfigs =
+{
+    {"default", nullptr, nullptr, false},
+    {"no_stats", "SOAPY_VOLK_STATS", "0", false},
+    {"fast_all", "SOAPY_VOLK_FAST_CONVERTERS", "all", false},
+    {"trace", "SOAPY_VOLK_TRACE", "BenchmarkSoapyVOLKConverters_startup.json", true},
+    {"metrics", "SOAPY_VOLK_METRICS", "BenchmarkSoapyVOLKConverters_startup.prom", true},
+    {"volk_generic", "VOLK_GENERIC", "1", false} // Forces VOLK's generic kernels
+};
+
+// How the benchmark was run, to find BenchmarkSoapyVOLKStartup beside it
+static std::string executablePath;
+
+// In microseconds
+struct StartupTimes
+{
+    double loadUs;
+    double firstConversionUs; // Including looking up the converter
+    double secondConversionUs;
+};
+
+static StartupTimes spawnStartupChild(const StartupConfig& config, const std::string& source, const std::string& target)
+{
+#ifdef _WIN32
+    (void)config;
+    (void)source;
+    (void)target;
+    throw std::runtime_error("--startup isn't supported on Windows");
+#else
+    for (const auto& other: StartupConfigs)
+    {
+        if (other.variable) unsetenv(other.variable);
+    }
+    if (config.variable) setenv(config.variable, config.value, 1);
+
+    const size_t separator = executablePath.find_last_of('/');
+    const std::string directory = (separator == std::string::npos) ? "." : executablePath.substr(0, separator);
+
+    const std::string command =
+        "'" + directory + "/BenchmarkSoapyVOLKStartup' '" + ModuleLoader::getModulePath() + "' " + source + " " + target + " " +
+        std::to_string(numElements);
+
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) throw std::runtime_error(std::string("popen: ") + std::strerror(errno));
+
+    StartupTimes times{0.0, 0.0, 0.0};
+    const int numRead = std::fscanf(pipe, "%lf %lf %lf", &times.loadUs, &times.firstConversionUs, &times.secondConversionUs);
+    const int status = pclose(pipe);
+    if ((numRead != 3) || (status != 0)) throw std::runtime_error("Failed to run " + command);
+
+    return times;
+#endif
+}
+
+static void recordStartup(
+    const std::string& config,
+    const std::string& phase,
+    size_t numElems,
+    const volk::vector<double>& timesUs,
+    const std::string& kernels)
+{
+    results.push_back(BenchmarkResults::Result{
+        "startup",
+        config,
+        phase,
+        "vectorized",
+        numElems,
+        TestUtility::median(timesUs),
+        TestUtility::medAbsDev(timesUs),
+        0.0,
+        timesUs.size(),
+        kernels});
+}
+
+static void benchmarkStartup(const StartupOptions& options)
+{
+    // The usual RX conversion, unless --pairs leaves it out
+    const auto pairs = listPairs();
+    if (pairs.empty()) return;
+
+    const std::pair<std::string, std::string> rxPair(SOAPY_SDR_CS16, SOAPY_SDR_CF32);
+    const auto& pair = (std::find(pairs.begin(), pairs.end(), rxPair) != pairs.end()) ? rxPair : pairs.front();
+    const auto kernels = getKernelDescription(pair.first, pair.second);
+
+    std::cout << std::endl << "Startup (" << pair.first << " -> " << pair.second << ", " << numElements << " elements, median of "
+              << options.runs << " processes):" << std::endl;
+    std::cout << std::setw(14) << "Config" << std::setw(16) << "loadModule us" << std::setw(18) << "First call us"
+              << std::setw(18) << "Second call us" << std::endl;
+
+    for (const auto& config: StartupConfigs)
+    {
+        try
+        {
+            volk::vector<double> loadUs, firstUs, secondUs;
+            for (size_t run = 0; run < options.runs; ++run)
+            {
+                const auto times = spawnStartupChild(config, pair.first, pair.second);
+                loadUs.push_back(times.loadUs);
+                firstUs.push_back(times.firstConversionUs);
+                secondUs.push_back(times.secondConversionUs);
+            }
+            if (config.valueIsFile) std::remove(config.value);
+
+            std::cout << std::setw(14) << config.name << std::setw(16) << TestUtility::median(loadUs)
+                      << std::setw(18) << TestUtility::median(firstUs) << std::setw(18) << TestUtility::median(secondUs) << std::endl;
+
+            recordStartup(config.name, "load_module", 0, loadUs, "");
+            recordStartup(config.name, "first_conversion", numElements, firstUs, kernels);
+            recordStartup(config.name, "second_conversion", numElements, secondUs, kernels);
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "Benchmark failed with exception: " << ex.what() << std::endl;
+        }
+    }
+}
+
+//
+// Options
+//
+
+struct Options
+{
+    bool stages{false};
+    bool sweep{false};
+    bool impls{false};
+    bool scaling{false};
+    ScalingOptions scalingOptions;
+    bool alignment{false};
+    AlignmentOptions alignmentOptions;
+    bool tail{false};
+    TailOptions tailOptions;
+    bool cold{false};
+    ColdOptions coldOptions;
+    size_t sweepMinElems{16};
+    size_t sweepMaxElems{size_t(1) << 26};
+
+    bool statsOverhead{false};
+    bool startup{false};
+    StartupOptions startupOptions;
+
+    std::vector<size_t> sizes{numElements};
+    std::string format{"text"};
+
+    std::string jsonPath;
+    std::string csvPath;
+    std::string baselinePath;
+    double thresholdPercent{5.0};
+
+    int pinCore{-1};
+    bool perf{false};
+
+    std::string modulePath;  // Empty for the build directory's
+    std::string modulePathB; // To compare against, if set
+};
+
+static size_t parseSize(const std::string& option, const std::string& value)
+{
+    size_t end = 0;
+    const auto size = std::stoull(value, &end);
+    if ((end != value.size()) || (size == 0)) throw std::invalid_argument("Invalid value for " + option + ": " + value);
+
+    return size_t(size);
+}
+
+static std::vector<std::string> splitList(const std::string& value)
+{
+    std::vector<std::string> items;
+    std::istringstream in(value);
+    std::string item;
+    while (std::getline(in, item, ',')) items.push_back(item);
+
+    return items;
+}
+
+// As source:target, where either can be "*"
+static std::pair<std::string, std::string> parsePair(const std::string& value)
+{
+    const auto colon = value.find(':');
+    if ((colon == std::string::npos) || (colon == 0) || (colon == (value.size() - 1))) throw std::invalid_argument("Invalid pair " + value + ", expected source:target");
+
+    return std::make_pair(value.substr(0, colon), value.substr(colon + 1));
+}
+
+static Options parseOptions(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        auto getValue = [&]() -> std::string
+        {
+            if (++i >= argc) throw std::invalid_argument(arg + " requires a value");
+            return argv[i];
+        };
+
+        if (arg == "--stages") options.stages = true;
+        else if (arg == "--sweep") options.sweep = true;
+        else if (arg == "--impls") options.impls = true;
+        else if (arg == "--scaling") options.scaling = true;
+        else if (arg == "--threads") options.scalingOptions.maxThreads = parseSize(arg, getValue());
+        else if (arg == "--scaling-elems") options.scalingOptions.numElems = parseSize(arg, getValue());
+        else if (arg == "--scaling-ms") options.scalingOptions.duration = std::chrono::milliseconds(parseSize(arg, getValue()));
+        else if (arg == "--alignment") options.alignment = true;
+        else if (arg == "--offset-step") options.alignmentOptions.offsetStep = parseSize(arg, getValue());
+        else if (arg == "--remainder-step") options.alignmentOptions.remainderStep = parseSize(arg, getValue());
+        else if (arg == "--tail") options.tail = true;
+        else if (arg == "--tail-calls") options.tailOptions.calls = parseSize(arg, getValue());
+        else if (arg == "--corunners") options.tailOptions.numCoRunners = size_t(std::stoul(getValue()));
+        else if (arg == "--corunner-mb") options.tailOptions.coRunnerBytes = parseSize(arg, getValue()) << 20;
+        else if (arg == "--cold") options.cold = true;
+        else if (arg == "--pool-mb") options.coldOptions.poolBytes = parseSize(arg, getValue()) << 20;
+        else if (arg == "--rate") options.coldOptions.rateMSps = std::stod(getValue());
+        else if (arg == "--min-elems") options.sweepMinElems = parseSize(arg, getValue());
+        else if (arg == "--max-elems") options.sweepMaxElems = parseSize(arg, getValue());
+        else if (arg == "--stats-overhead") options.statsOverhead = true;
+        else if (arg == "--startup") options.startup = true;
+        else if (arg == "--startup-runs") options.startupOptions.runs = parseSize(arg, getValue());
+        else if (arg == "--pairs")
+        {
+            for (const auto& pair: splitList(getValue())) pairFilters.push_back(parsePair(pair));
+        }
+        else if (arg == "--sizes")
+        {
+            options.sizes.clear();
+            for (const auto& size: splitList(getValue())) options.sizes.push_back(parseSize(arg, size));
+            if (options.sizes.empty()) throw std::invalid_argument("--sizes requires at least one size");
+        }
+        else if (arg == "--format") options.format = getValue();
+        else if (arg == "--signal") signal = TestUtility::getSignal(getValue());
+        else if (arg == "--snr") snrDB = std::stod(getValue());
+        else if (arg == "--seed") TestUtility::setRandomSeed(std::stoull(getValue()));
+        else if (arg == "--iterations") timing.iterations = parseSize(arg, getValue());
+        else if (arg == "--ci") timing.targetCIPercent = std::stod(getValue());
+        else if (arg == "--max-time-ms") timing.maxTime = std::chrono::milliseconds(parseSize(arg, getValue()));
+        else if (arg == "--warmup-ms") timing.warmup = std::chrono::milliseconds(std::stoul(getValue()));
+        else if (arg == "--pin") options.pinCore = int(std::stoul(getValue()));
+        else if (arg == "--perf") options.perf = true;
+        else if (arg == "--module") options.modulePath = getValue();
+        else if (arg == "--ab") options.modulePathB = getValue();
+        else if (arg == "--json") options.jsonPath = getValue();
+        else if (arg == "--csv") options.csvPath = getValue();
+        else if (arg == "--compare") options.baselinePath = getValue();
+        else if (arg == "--threshold") options.thresholdPercent = std::stod(getValue());
+        else throw std::invalid_argument("Unknown option " + arg);
+    }
+    if (options.sweepMinElems > options.sweepMaxElems) throw std::invalid_argument("--min-elems is larger than --max-elems");
+    if ((options.format != "text") && (options.format != "json") && (options.format != "csv")) throw std::invalid_argument("Unknown format " + options.format);
+
+    // Co-runners need cores of their own, after the converter's.
+    if (options.tail && (options.pinCore < 0)) options.pinCore = 0;
+
+    return options;
+}
+
+//
+// Default benchmark
+//
+
+static bool isZeroSkipping(const std::string& source, const std::string& target)
+{
+    return ((source == SOAPY_SDR_F32) || (source == SOAPY_SDR_CF32)) && (target.find('S') != std::string::npos);
+}
+
+static void benchmarkAllConverters()
+{
+    const auto pairs = listPairs();
+    for (const auto& pair: pairs) benchmarkPair(pair.first, pair.second);
+
+    // Sparse-burst TX inputs
+    std::cout << std::endl << "Zero-skip:" << std::endl;
+    for (const auto& pair: pairs)
+    {
+        if (isZeroSkipping(pair.first, pair.second)) benchmarkSparseBurst(pair.first, pair.second);
+    }
+}
+
+// Returns false if there were regressions.
+static bool writeResults(const Options& options)
+{
+    if (!options.jsonPath.empty() || !options.csvPath.empty())
+    {
+        const auto host = BenchmarkResults::getHostInfo(SoapySDR::getModuleVersion(ModuleLoader::getModulePath()));
+        if (!options.jsonPath.empty()) BenchmarkResults::writeJSON(options.jsonPath, host, results);
+        if (!options.csvPath.empty()) BenchmarkResults::writeCSV(options.csvPath, host, results);
+    }
+
+    if (options.baselinePath.empty()) return true;
+
+    const auto baseline = BenchmarkResults::read(options.baselinePath);
+    return (BenchmarkResults::compare(baseline, results, options.thresholdPercent) == 0);
+}
+
+// Usage: BenchmarkSoapyVOLKConverters [options]
+//
+// --stages:          only break down the time of each vectorized converter
+//                    that calls two kernels by stage
+// --sweep:           only sweep buffer sizes in powers of two, reporting
+//                    throughput and where VOLK overtakes the generic
+//                    converters
+// --impls:           only time every VOLK implementation of each kernel the
+//                    converters call, aligned and unaligned, and rank them
+// --scaling:         only convert concurrently from 1 to --threads threads,
+//                    reporting total and per-thread throughput against
+//                    memcpy's with as many threads
+// --threads <num>:   most threads for --scaling (default all cores)
+// --scaling-elems <num>: elements per thread for --scaling (default 1M)
+// --scaling-ms <ms>: time spent on each thread count (default 250)
+// --alignment:       only time each vectorized converter with source and
+//                    destination offset from alignment by 0 to 63 bytes, and
+//                    with 0 to 63 elements past a multiple of every SIMD
+//                    width, against aligned buffers
+// --offset-step <bytes>: bytes between --alignment offsets (default 8)
+// --remainder-step <num>: elements between --alignment lengths (default 1)
+// --tail:            only measure each vectorized converter's p50, p99,
+//                    p99.9, and maximum latency, alone and with co-runner
+//                    threads loading memory and the last-level cache
+// --tail-calls <num>: calls per --tail measurement (default 20000)
+// --corunners <num>: co-runner threads for --tail (default 2)
+// --corunner-mb <MB>: memory each co-runner uses (default the last-level
+//                    cache's size)
+// --cold:            only compare each vectorized converter on one buffer
+//                    against rotating through a pool of buffers larger than
+//                    the last-level cache
+// --pool-mb <MB>:    pool size for --cold (default twice the last-level
+//                    cache)
+// --rate <MS/s>:     with --cold, also call at this sample rate and report
+//                    latency from when each buffer is due
+// --stats-overhead: only compare each vectorized converter with statistics
+//                    enabled and disabled, at 4096 elements, interleaving
+//                    their calls
+// --startup:        only time loading the module and the first and second
+//                    conversions, in new processes, with each of the
+//                    module's and VOLK's load-time options
+// --startup-runs <num>: processes per --startup configuration (default 20)
+// --pairs <list>:   only benchmark these conversions, as comma-separated
+//                    source:target pairs, where either can be * (default
+//                    every conversion the module registers)
+// --sizes <list>:    comma-separated buffer sizes for the default benchmark,
+//                    the first also used by other modes (default 16384)
+// --format <fmt>:    text, or json or csv to write results to stdout and
+//                    everything else to stderr (default text)
+// --signal <name>:  input for every mode: uniform, tone, noisy_tone,
+//                    clipped_burst, sparse_zeros, denormal_decay, or
+//                    full_scale_edges (default uniform)
+// --snr <dB>:        SNR of noisy_tone and sparse_zeros (default 20)
+// --seed <num>:      seed for every input, to reproduce a run (default
+//                    random, and printed)
+// --min-elems <num>: smallest sweep size (default 16)
+// --max-elems <num>: largest sweep size (default 64M)
+// --iterations <num>: time a fixed number of calls, instead of calling until
+//                    the median's 95% confidence interval is narrow enough
+// --ci <pct>:        target confidence interval, as a percentage of the
+//                    median (default 1%)
+// --max-time-ms <ms>: longest to spend on one measurement (default 2000)
+// --warmup-ms <ms>:  time spent calling before each measurement (default 10)
+// --pin <core>:      pin the benchmark to a core (with --tail, core 0 by
+//                    default), and with --scaling and --tail, each further
+//                    thread to the next core
+// --perf:            also count cycles, instructions, cache misses, and
+//                    branch misses with hardware counters (Linux only)
+// --module <path>:   load the module from this path, instead of the build
+//                    directory
+// --ab <path>:       only compare the module with another build, loaded
+//                    from this path, interleaving their calls
+// --json <path>:     also write results, with the host's CPU, SoapySDR and
+//                    VOLK versions, and VOLK implementations, as JSON
+// --csv <path>:      the same, as CSV
+// --compare <path>:  compare results with a baseline written by --json or
+//                    --csv, and fail if any vectorized converter is slower
+//                    by more than the threshold
+// --threshold <pct>: regression threshold for --compare (default 5%)
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Measured against steady_clock while the module loads
+        const SoapyVOLKConverters::CycleTimerCalibration calibration;
+
+        const auto options = parseOptions(argc, argv);
+        numElements = options.sizes.front();
+
+        executablePath = argv[0];
+
+        // Keep stdout for the results alone.
+        std::streambuf* stdoutBuffer = nullptr;
+        if (options.format != "text") stdoutBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+
+        if ((options.pinCore >= 0) && !TestUtility::pinThreadToCore(size_t(options.pinCore)))
+        {
+            std::cerr << "Failed to pin to core " << options.pinCore << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // Counters follow the thread that opens them.
+        if (options.perf)
+        {
+            perfCounters.reset(new PerfCounters);
+            if (!perfCounters->available())
+            {
+                std::cerr << "Hardware counters unavailable, continuing without them: " << perfCounters->getError() << std::endl;
+                perfCounters.reset();
+            }
+        }
+
+        std::vector<std::string> modulePaths{options.modulePath};
+        if (!options.modulePathB.empty()) modulePaths.push_back(options.modulePathB);
+        if (!ModuleLoader::loadSoapyVOLK(modulePaths)) return EXIT_FAILURE;
+
+        // Both builds are timed without statistics, like the generic converters.
+        setStatsEnabled(false);
+        if (!options.modulePathB.empty())
+        {
+            auto setStatsEnabledB = GET_MODULE_FUNCTION_FROM(options.modulePathB, SoapyVOLKConverters_setStatsEnabled);
+            setStatsEnabledB(false);
+        }
+
+        ticksPerNs = calibration.ticksPerNanosecond(std::chrono::milliseconds(100));
+
+        std::cout << "SoapyVOLKConverters " << SoapySDR::getModuleVersion(ModuleLoader::getModulePath()) << std::endl;
+        std::cout << "SoapySDR            " << SoapySDR::getLibVersion() << std::endl;
+        std::cout << "VOLK                " << volk_version() << std::endl;
+        std::cout << "Random seed         " << TestUtility::getRandomSeed() << std::endl;
+
+        if (!options.modulePathB.empty()) compareAllModules(options.modulePathB);
+        else if (options.stages) benchmarkAllStages();
+        else if (options.sweep) sweepAllConverters(options.sweepMinElems, options.sweepMaxElems);
+        else if (options.impls) benchmarkAllImpls();
+        else if (options.alignment) benchmarkAllAlignments(options.alignmentOptions);
+        else if (options.tail)
+        {
+            auto tailOptions = options.tailOptions;
+            tailOptions.firstCore = options.pinCore;
+            benchmarkAllTails(tailOptions);
+        }
+        else if (options.cold) benchmarkAllCold(options.coldOptions);
+        else if (options.statsOverhead) benchmarkAllStatsOverhead();
+        else if (options.startup) benchmarkStartup(options.startupOptions);
+        else if (options.scaling)
+        {
+            auto scalingOptions = options.scalingOptions;
+            scalingOptions.firstCore = options.pinCore;
+            scaleAllConverters(scalingOptions);
+        }
+        else
+        {
+            std::cout << std::endl;
+            std::cout << "Stats:" << std::endl;
+            std::cout << " * Signal:       " << TestUtility::getSignalName(signal) << std::endl;
+            std::cout << " * Buffer size:  ";
+            for (size_t i = 0; i < options.sizes.size(); ++i) std::cout << ((i > 0) ? ", " : "") << options.sizes[i];
+            std::cout << std::endl;
+            if (timing.iterations > 0) std::cout << " * # iterations: " << timing.iterations << std::endl;
+            else std::cout << " * # iterations: until the median is within " << timing.targetCIPercent << "% at 95% confidence" << std::endl;
+
+            for (const size_t size: options.sizes)
+            {
+                numElements = size;
+                if (options.sizes.size() > 1) std::cout << std::endl << "Buffer size: " << numElements << std::endl;
+                benchmarkAllConverters();
+            }
+        }
+
+        const bool passed = writeResults(options);
+        if (stdoutBuffer)
+        {
+            std::cout.rdbuf(stdoutBuffer);
+
+            const auto host = BenchmarkResults::getHostInfo(SoapySDR::getModuleVersion(ModuleLoader::getModulePath()));
+            if (options.format == "json") BenchmarkResults::writeJSON(std::cout, host, results);
+            else BenchmarkResults::writeCSV(std::cout, host, results);
+        }
+        if (!passed) return EXIT_FAILURE;
     }
     catch(const std::exception& ex)
     {
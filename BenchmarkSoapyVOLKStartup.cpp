@@ -0,0 +1,99 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+//
+// Child process for BenchmarkSoapyVOLKConverters --startup. Only links
+// SoapySDR, so VOLK is first loaded and initialized by the module, within the
+// timed loadModule() and first conversion.
+//
+// Usage: BenchmarkSoapyVOLKStartup <module path> <source> <target> <elements>
+//
+// Prints the microseconds spent loading the module, on the first conversion,
+// and on the second.
+//
+
+#include <SoapySDR/ConverterRegistry.hpp>
+#include <SoapySDR/Formats.hpp>
+#include <SoapySDR/Logger.hpp>
+#include <SoapySDR/Modules.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Enough for any SIMD width, so VOLK takes its aligned path as it would with
+// volk_malloc()'s buffers
+static constexpr size_t BufferAlignment = 64;
+
+static uint8_t* alignBuffer(std::vector<uint8_t>& buffer)
+{
+    const auto address = reinterpret_cast<uintptr_t>(buffer.data());
+    return buffer.data() + ((BufferAlignment - (address % BufferAlignment)) % BufferAlignment);
+}
+
+int main(int argc, char** argv)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto toUs = [](Clock::duration duration) { return std::chrono::duration<double, std::micro>(duration).count(); };
+
+    if (argc != 5)
+    {
+        std::cerr << "Usage: " << argv[0] << " <module path> <source> <target> <elements>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string modulePath(argv[1]);
+    const std::string source(argv[2]);
+    const std::string target(argv[3]);
+    const size_t numElems = size_t(std::stoull(argv[4]));
+
+    try
+    {
+        // The parent reports anything that goes wrong.
+        SoapySDR::setLogLevel(SOAPY_SDR_ERROR);
+
+        // Allocated and touched first, so only the module's own work is
+        // timed. Every byte is 0x3F, a nonzero value in range for every
+        // format, so zero-skipping converters convert all of it.
+        std::vector<uint8_t> inputBuffer((numElems * SoapySDR::formatToSize(source)) + BufferAlignment, 0x3F);
+        std::vector<uint8_t> outputBuffer((numElems * SoapySDR::formatToSize(target)) + BufferAlignment, 0);
+        const uint8_t* input = alignBuffer(inputBuffer);
+        uint8_t* output = alignBuffer(outputBuffer);
+
+        // Scales integers to and from [-1, 1), as the benchmark does
+        const auto getFullScale = [](std::string format)
+        {
+            if (format[0] == 'C') format = format.substr(1);
+            if (format == SOAPY_SDR_S8) return double(1 << 7);
+            if (format == SOAPY_SDR_S16) return double(1 << 15);
+            if (format == SOAPY_SDR_S32) return double(uint32_t(1) << 31);
+
+            return 1.0;
+        };
+        const double scalar = getFullScale(target) / getFullScale(source);
+
+        const auto start = Clock::now();
+        SoapySDR::loadModule(modulePath);
+        const auto loaded = Clock::now();
+
+        auto converterFunc = SoapySDR::ConverterRegistry::getFunction(source, target, SoapySDR::ConverterRegistry::VECTORIZED);
+        converterFunc(input, output, numElems, scalar);
+        const auto converted = Clock::now();
+
+        converterFunc(input, output, numElems, scalar);
+        const auto convertedAgain = Clock::now();
+
+        std::cout << std::setprecision(9) << toUs(loaded - start) << " " << toUs(converted - loaded) << " " << toUs(convertedAgain - converted) << std::endl;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Startup benchmark failed with exception: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SOAPY_VOLK_HAVE_RDTSC
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace SoapyVOLKConverters
+{
+    // The CPU's timestamp counter where there's a cheap, constant-rate one,
+    // and steady_clock nanoseconds otherwise. Only differences are meaningful.
+    inline uint64_t readCycleCounter()
+    {
+#if defined(SOAPY_VOLK_HAVE_RDTSC)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    //
+    // Measures the cycle counter's rate against steady_clock, from the time
+    // it's constructed to the time it's read. Constructing it early and
+    // reading it late costs nothing up front and improves accuracy.
+    //
+    class CycleTimerCalibration
+    {
+    public:
+        CycleTimerCalibration():
+            _startTicks(readCycleCounter()),
+            _startTime(std::chrono::steady_clock::now())
+        {
+        }
+
+        // Waits until at least minInterval has passed since construction.
+        double ticksPerNanosecond(const std::chrono::nanoseconds minInterval = std::chrono::milliseconds(10)) const
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - _startTime;
+            if(elapsed < minInterval) std::this_thread::sleep_for(minInterval - elapsed);
+
+            const uint64_t endTicks = readCycleCounter();
+            const auto endTime = std::chrono::steady_clock::now();
+
+            const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - _startTime);
+            return double(endTicks - _startTicks) / double(nanoseconds.count());
+        }
+
+    private:
+        uint64_t _startTicks;
+        std::chrono::steady_clock::time_point _startTime;
+    };
+
+    // The module's calibration, measured once and shared by statistics and
+    // tracing so their times agree. Defined in Instrumentation.cpp.
+    double getTicksPerNanosecond();
+}
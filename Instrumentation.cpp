@@ -0,0 +1,918 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#include "CycleTimer.hpp"
+#include "Instrumentation.hpp"
+#include "Probes.hpp"
+#include "SoapyVOLKConverters.hpp"
+#include "Tracing.hpp"
+
+#include <SoapySDR/Formats.hpp>
+#include <SoapySDR/Logger.hpp>
+
+#include <volk/volk.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SoapyVOLKConverters
+{
+    //
+    // Converter table
+    //
+
+    // Enough for every exact and fast converter, plus fast converters
+    // promoted to the default.
+    static constexpr size_t MaxConverters = 128;
+
+    // Counts output samples at the limits of the output type.
+    using SaturationCounter = uint64_t(*)(const void*, size_t);
+
+    struct ConverterInfo
+    {
+        const char* sourceFormat;
+        const char* targetFormat;
+        SoapySDR::ConverterRegistry::FunctionPriority priority;
+        SoapySDR::ConverterRegistry::ConverterFunction function;
+        size_t bytesPerElem;
+
+        // Comma-separated, or null if the converter doesn't call VOLK
+        const char* kernels;
+
+        // Only set for float to integer converters
+        SaturationCounter countSaturated;
+        size_t samplesPerElem;
+    };
+
+    // Registrations run during static initialization, possibly before this
+    // file's dynamic initializers, so everything they touch is either
+    // zero-initialized or constant-initialized.
+    static ConverterInfo Converters[MaxConverters];
+    static size_t NumConverters = 0;
+
+    static std::atomic<bool> StatsEnabled(true);
+    static std::atomic<bool> LogStatsOnUnload(false);
+    static std::atomic<bool> SaturationCountingEnabled(false);
+
+    // Each converter's saturation counter while counting is enabled, so a
+    // call only loads its own slot
+    static std::array<std::atomic<SaturationCounter>, MaxConverters> ActiveSaturationCounters;
+    static std::atomic<bool> StageTimingEnabled(false);
+
+    // Set when the module is loaded
+    static size_t VOLKAlignmentMask = 0;
+
+    static std::string& getLatencyCSVPath()
+    {
+        static std::string path;
+        return path;
+    }
+
+    static const CycleTimerCalibration Calibration;
+
+    //
+    // Latency histograms
+    //
+
+    // HDR-style buckets: exact below 8 ticks, then 8 linear sub-buckets per
+    // power of two, so each bucket is within 12.5% of its values. Ticks are
+    // offset by 8 before bucketing, so one bit scan finds every bucket.
+    static constexpr size_t SubBucketBits = 3;
+    static constexpr size_t NumSubBuckets = (1 << SubBucketBits);
+    static constexpr size_t MaxLatencyBits = 36;
+    static constexpr size_t NumLatencyBuckets = (MaxLatencyBits - SubBucketBits + 1) * NumSubBuckets;
+
+    // Buffers of <256, <1K, <4K, <16K, <64K, <256K, <1M, and 1M+ elements
+    static constexpr size_t NumSizeClasses = 8;
+
+    static size_t mostSignificantBit(const uint64_t value)
+    {
+#ifdef _MSC_VER
+        // _BitScanReverse64 isn't available on 32-bit targets.
+        unsigned long index;
+        if(_BitScanReverse(&index, static_cast<unsigned long>(value >> 32))) return (index + 32);
+        _BitScanReverse(&index, static_cast<unsigned long>(value));
+        return index;
+#else
+        return size_t(63 - __builtin_clzll(value));
+#endif
+    }
+
+    static size_t getLatencyBucket(const uint64_t ticks)
+    {
+        static constexpr uint64_t MaxOffsetTicks = (uint64_t(1) << (MaxLatencyBits + 1)) - 1;
+
+        const uint64_t offsetTicks = std::min(ticks + NumSubBuckets, MaxOffsetTicks);
+        const size_t group = mostSignificantBit(offsetTicks) - SubBucketBits;
+        const size_t subBucket = size_t(offsetTicks >> group) & (NumSubBuckets - 1);
+
+        return (group * NumSubBuckets) + subBucket;
+    }
+
+    static uint64_t getLatencyBucketMinTicks(const size_t bucket)
+    {
+        const size_t group = bucket / NumSubBuckets;
+        const size_t subBucket = bucket % NumSubBuckets;
+
+        return (uint64_t(NumSubBuckets + subBucket) << group) - NumSubBuckets;
+    }
+
+    // Setting bit 7 puts everything under 256 elements in the first class,
+    // which small-buffer calls are counted from.
+    static_assert(SmallBufferElems == 256, "Small-buffer calls are the first size class");
+
+    static size_t getSizeClass(const size_t numElems)
+    {
+        return std::min(NumSizeClasses - 1, (mostSignificantBit(uint64_t(numElems) | 128) - 6) / 2);
+    }
+
+    static size_t getSizeClassMinElems(const size_t sizeClass)
+    {
+        return (sizeClass == 0) ? 0 : (size_t(1) << (8 + (2 * (sizeClass - 1))));
+    }
+
+    double getTicksPerNanosecond()
+    {
+        static const double ticksPerNs = Calibration.ticksPerNanosecond();
+        return ticksPerNs;
+    }
+
+    //
+    // Per-thread counters
+    //
+
+    // Only the owning thread writes, so a relaxed load and store is enough
+    // and avoids a locked instruction per update.
+    class ThreadCounter
+    {
+    public:
+        void add(const uint64_t value)
+        {
+            _value.store(_value.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        uint64_t get() const
+        {
+            return _value.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint64_t> _value{0};
+    };
+
+    using LatencyHistograms = std::array<std::array<ThreadCounter, NumLatencyBuckets>, NumSizeClasses>;
+
+    // Everything a call updates comes first, in one cache line. Call counts
+    // are indexed by whether the buffers were unaligned, and small-buffer
+    // calls are read from the histograms, so neither needs a branch.
+    struct alignas(64) ConverterCounters
+    {
+        std::array<ThreadCounter, 2> callsByAlignment;
+        ThreadCounter elements;
+        ThreadCounter ticks;
+
+        // Histograms are large, so each thread only allocates them for the
+        // converters it calls. Atomic so readers see them once allocated.
+        std::atomic<LatencyHistograms*> histograms{nullptr};
+
+        ThreadCounter zeroSkipCalls;
+        ThreadCounter saturatedSamples;
+        ThreadCounter stageTimedCalls;
+        std::array<ThreadCounter, NumConverterStages> stageTicks;
+        ThreadCounter allocations;
+        ThreadCounter allocatedBytes;
+    };
+
+    struct ConverterTotals
+    {
+        uint64_t calls{0};
+        uint64_t elements{0};
+        uint64_t ticks{0};
+        uint64_t unalignedCalls{0};
+        uint64_t smallBufferCalls{0};
+        uint64_t zeroSkipCalls{0};
+        uint64_t saturatedSamples{0};
+        uint64_t stageTimedCalls{0};
+        std::array<uint64_t, NumConverterStages> stageTicks{};
+        uint64_t allocations{0};
+        uint64_t allocatedBytes{0};
+
+        void add(const ConverterCounters& counters)
+        {
+            calls += counters.callsByAlignment[0].get() + counters.callsByAlignment[1].get();
+            elements += counters.elements.get();
+            ticks += counters.ticks.get();
+            unalignedCalls += counters.callsByAlignment[1].get();
+
+            const auto* histograms = counters.histograms.load(std::memory_order_acquire);
+            if(histograms)
+            {
+                for(const auto& count: (*histograms)[0]) smallBufferCalls += count.get();
+            }
+
+            zeroSkipCalls += counters.zeroSkipCalls.get();
+            saturatedSamples += counters.saturatedSamples.get();
+            stageTimedCalls += counters.stageTimedCalls.get();
+            for(size_t stage = 0; stage < NumConverterStages; ++stage) stageTicks[stage] += counters.stageTicks[stage].get();
+            allocations += counters.allocations.get();
+            allocatedBytes += counters.allocatedBytes.get();
+        }
+
+        void subtract(const ConverterTotals& totals)
+        {
+            calls -= totals.calls;
+            elements -= totals.elements;
+            ticks -= totals.ticks;
+            unalignedCalls -= totals.unalignedCalls;
+            smallBufferCalls -= totals.smallBufferCalls;
+            zeroSkipCalls -= totals.zeroSkipCalls;
+            saturatedSamples -= totals.saturatedSamples;
+            stageTimedCalls -= totals.stageTimedCalls;
+            for(size_t stage = 0; stage < NumConverterStages; ++stage) stageTicks[stage] -= totals.stageTicks[stage];
+            allocations -= totals.allocations;
+            allocatedBytes -= totals.allocatedBytes;
+        }
+    };
+
+    using ConverterTotalsArray = std::array<ConverterTotals, MaxConverters>;
+
+    // A maximum can't be reset by subtracting a baseline, so peaks are shared
+    // between threads. They're only written when a call sets a new peak.
+    static std::array<std::atomic<uint64_t>, MaxConverters> PeakScratchBytes;
+
+    static void updatePeak(std::atomic<uint64_t>& peak, const uint64_t value)
+    {
+        uint64_t current = peak.load(std::memory_order_relaxed);
+        while((value > current) && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed));
+    }
+
+    struct LatencyHistogramTotals
+    {
+        std::array<std::array<uint64_t, NumLatencyBuckets>, NumSizeClasses> counts{};
+
+        void add(const LatencyHistograms& histograms)
+        {
+            for(size_t sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+            {
+                for(size_t bucket = 0; bucket < NumLatencyBuckets; ++bucket)
+                {
+                    counts[sizeClass][bucket] += histograms[sizeClass][bucket].get();
+                }
+            }
+        }
+
+        void add(const LatencyHistogramTotals& totals)
+        {
+            for(size_t sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+            {
+                for(size_t bucket = 0; bucket < NumLatencyBuckets; ++bucket)
+                {
+                    counts[sizeClass][bucket] += totals.counts[sizeClass][bucket];
+                }
+            }
+        }
+
+        void subtract(const LatencyHistogramTotals& totals)
+        {
+            for(size_t sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+            {
+                for(size_t bucket = 0; bucket < NumLatencyBuckets; ++bucket)
+                {
+                    counts[sizeClass][bucket] -= totals.counts[sizeClass][bucket];
+                }
+            }
+        }
+    };
+
+    struct ThreadCounters
+    {
+        ThreadCounters();
+        ~ThreadCounters();
+
+        std::array<ConverterCounters, MaxConverters> converters;
+    };
+
+    struct CountersRegistry
+    {
+        std::mutex mutex;
+        std::vector<const ThreadCounters*> threads;
+
+        // Counts from threads that have exited
+        ConverterTotalsArray retired;
+        std::array<std::unique_ptr<LatencyHistogramTotals>, MaxConverters> retiredHistograms;
+
+        // Subtracted from reads, so resetting doesn't write to other
+        // threads' counters
+        ConverterTotalsArray baseline;
+        std::array<std::unique_ptr<LatencyHistogramTotals>, MaxConverters> baselineHistograms;
+    };
+
+    // Never destroyed, as threads may exit after the module's static
+    // destructors run.
+    static CountersRegistry& getCountersRegistry()
+    {
+        static auto* registry = new CountersRegistry;
+        return *registry;
+    }
+
+    ThreadCounters::ThreadCounters()
+    {
+        auto& registry = getCountersRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back(this);
+    }
+
+    ThreadCounters::~ThreadCounters()
+    {
+        auto& registry = getCountersRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        for(size_t i = 0; i < MaxConverters; ++i)
+        {
+            registry.retired[i].add(converters[i]);
+
+            std::unique_ptr<LatencyHistograms> histogram(converters[i].histograms.load());
+            if(histogram)
+            {
+                auto& retired = registry.retiredHistograms[i];
+                if(!retired) retired.reset(new LatencyHistogramTotals);
+                retired->add(*histogram);
+            }
+        }
+        registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+    }
+
+    static ThreadCounters& getThreadCounters()
+    {
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    // Caller must hold the registry mutex.
+    static ConverterTotalsArray sumCounters(const CountersRegistry& registry)
+    {
+        ConverterTotalsArray totals = registry.retired;
+        for(const auto* thread: registry.threads)
+        {
+            for(size_t i = 0; i < MaxConverters; ++i) totals[i].add(thread->converters[i]);
+        }
+
+        return totals;
+    }
+
+    static ConverterTotalsArray getTotals()
+    {
+        auto& registry = getCountersRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto totals = sumCounters(registry);
+        for(size_t i = 0; i < MaxConverters; ++i) totals[i].subtract(registry.baseline[i]);
+
+        return totals;
+    }
+
+    // Caller must hold the registry mutex.
+    static LatencyHistogramTotals sumLatencyHistograms(const CountersRegistry& registry, const size_t index)
+    {
+        LatencyHistogramTotals totals;
+        if(registry.retiredHistograms[index]) totals.add(*registry.retiredHistograms[index]);
+
+        for(const auto* thread: registry.threads)
+        {
+            const auto* histogram = thread->converters[index].histograms.load(std::memory_order_acquire);
+            if(histogram) totals.add(*histogram);
+        }
+
+        return totals;
+    }
+
+    static LatencyHistogramTotals getLatencyHistogramTotals(const size_t index)
+    {
+        auto& registry = getCountersRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto totals = sumLatencyHistograms(registry, index);
+        if(registry.baselineHistograms[index]) totals.subtract(*registry.baselineHistograms[index]);
+
+        return totals;
+    }
+
+    // Only on a thread's first recorded call to a converter
+    static LatencyHistograms* allocateLatencyHistograms(ConverterCounters& counters)
+    {
+        auto* histograms = new LatencyHistograms;
+        counters.histograms.store(histograms, std::memory_order_release);
+
+        return histograms;
+    }
+
+    //
+    // Saturation
+    //
+
+    template <typename T>
+    static uint64_t countSaturated(const void* buff, const size_t numSamples)
+    {
+        const auto* samples = reinterpret_cast<const T*>(buff);
+
+        uint64_t count = 0;
+        for(size_t i = 0; i < numSamples; ++i)
+        {
+            count += ((samples[i] == std::numeric_limits<T>::max()) || (samples[i] == std::numeric_limits<T>::min())) ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    static SaturationCounter getSaturationCounter(const char* sourceFormat, const char* targetFormat)
+    {
+        if(sourceFormat[0] == 'C') ++sourceFormat;
+        if(targetFormat[0] == 'C') ++targetFormat;
+        if(sourceFormat[0] != 'F') return nullptr;
+
+        if(0 == std::strcmp(targetFormat, "S8")) return &countSaturated<int8_t>;
+        if(0 == std::strcmp(targetFormat, "S16")) return &countSaturated<int16_t>;
+        if(0 == std::strcmp(targetFormat, "S32")) return &countSaturated<int32_t>;
+
+        return nullptr;
+    }
+
+    //
+    // Entry points
+    //
+
+    // Lets converters report on the call being recorded on this thread.
+    static thread_local ConverterCounters* CurrentCounters = nullptr;
+    static thread_local size_t CurrentConverter = 0;
+
+    void countZeroSkipCall()
+    {
+        if(CurrentCounters) CurrentCounters->zeroSkipCalls.add(1);
+    }
+
+    void countScratchAllocation(const size_t bytes)
+    {
+        if(!CurrentCounters) return;
+
+        CurrentCounters->allocations.add(1);
+        CurrentCounters->allocatedBytes.add(bytes);
+        updatePeak(PeakScratchBytes[CurrentConverter], bytes);
+    }
+
+    StageTimer::StageTimer():
+        _enabled(CurrentCounters && StageTimingEnabled.load(std::memory_order_relaxed))
+    {
+        if(!_enabled) return;
+
+        CurrentCounters->stageTimedCalls.add(1);
+        _lastTicks = readCycleCounter();
+    }
+
+    StageTimer::~StageTimer()
+    {
+        endStage(AllocStage);
+    }
+
+    void StageTimer::endStage(const ConverterStage stage)
+    {
+        if(!_enabled) return;
+
+        const uint64_t ticks = readCycleCounter();
+        CurrentCounters->stageTicks[stage].add(ticks - _lastTicks);
+        _lastTicks = ticks;
+    }
+
+    static void callConverterFunction(
+        const ConverterInfo& converter,
+        const void* srcBuff,
+        void* dstBuff,
+        const size_t numElems,
+        const double scalar)
+    {
+        uint64_t scalarBits;
+        std::memcpy(&scalarBits, &scalar, sizeof(scalarBits));
+
+        SOAPY_VOLK_PROBE4(convert_entry, converter.sourceFormat, converter.targetFormat, numElems, scalarBits);
+        converter.function(srcBuff, dstBuff, numElems, scalar);
+        SOAPY_VOLK_PROBE4(convert_exit, converter.sourceFormat, converter.targetFormat, numElems, scalarBits);
+    }
+
+    static void callConverter(
+        const size_t index,
+        const void* srcBuff,
+        void* dstBuff,
+        const size_t numElems,
+        const double scalar)
+    {
+        const auto& converter = Converters[index];
+
+        const bool statsEnabled = StatsEnabled.load(std::memory_order_relaxed);
+        if(!statsEnabled && !TraceEnabled)
+        {
+            callConverterFunction(converter, srcBuff, dstBuff, numElems, scalar);
+            return;
+        }
+
+        auto& counters = getThreadCounters().converters[index];
+        CurrentCounters = statsEnabled ? &counters : nullptr;
+        CurrentConverter = index;
+
+        const uint64_t startTicks = readCycleCounter();
+        callConverterFunction(converter, srcBuff, dstBuff, numElems, scalar);
+        const uint64_t endTicks = readCycleCounter();
+
+        CurrentCounters = nullptr;
+
+        if(TraceEnabled)
+        {
+            traceConverterCall(converter.sourceFormat, converter.targetFormat, numElems, startTicks, endTicks);
+        }
+        if(!statsEnabled) return;
+
+        const uint64_t ticks = endTicks - startTicks;
+        const bool unaligned = (((reinterpret_cast<uintptr_t>(srcBuff) | reinterpret_cast<uintptr_t>(dstBuff)) & VOLKAlignmentMask) != 0);
+
+        counters.callsByAlignment[unaligned].add(1);
+        counters.elements.add(numElems);
+        counters.ticks.add(ticks);
+
+        auto* histograms = counters.histograms.load(std::memory_order_relaxed);
+        if(!histograms) histograms = allocateLatencyHistograms(counters);
+        (*histograms)[getSizeClass(numElems)][getLatencyBucket(ticks)].add(1);
+
+        const auto countSaturated = ActiveSaturationCounters[index].load(std::memory_order_relaxed);
+        if(countSaturated)
+        {
+            counters.saturatedSamples.add(countSaturated(dstBuff, (numElems * converter.samplesPerElem)));
+        }
+    }
+
+    // SoapySDR converters are plain function pointers, so each table slot
+    // gets its own function to know which converter it's calling.
+    template <size_t Index>
+    static void callConverter(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
+    {
+        callConverter(Index, srcBuff, dstBuff, numElems, scalar);
+    }
+
+    template <size_t... Indices>
+    static constexpr std::array<SoapySDR::ConverterRegistry::ConverterFunction, sizeof...(Indices)> makeEntryPoints(std::index_sequence<Indices...>)
+    {
+        return {{&callConverter<Indices>...}};
+    }
+
+    static constexpr auto EntryPoints = makeEntryPoints(std::make_index_sequence<MaxConverters>());
+
+    static SoapySDR::ConverterRegistry::ConverterFunction addConverter(
+        const char* sourceFormat,
+        const char* targetFormat,
+        const SoapySDR::ConverterRegistry::FunctionPriority priority,
+        SoapySDR::ConverterRegistry::ConverterFunction function,
+        const char* kernels)
+    {
+        if(NumConverters == MaxConverters)
+        {
+            SoapySDR::logf(
+                SOAPY_SDR_ERROR,
+                "SoapyVOLKConverters: too many converters, %s -> %s won't record statistics",
+                sourceFormat,
+                targetFormat);
+            return function;
+        }
+
+        const size_t index = NumConverters++;
+        Converters[index] = ConverterInfo{
+            sourceFormat,
+            targetFormat,
+            priority,
+            function,
+            (SoapySDR::formatToSize(sourceFormat) + SoapySDR::formatToSize(targetFormat)),
+            kernels,
+            getSaturationCounter(sourceFormat, targetFormat),
+            ((targetFormat[0] == 'C') ? 2U : 1U)};
+        if(SaturationCountingEnabled) ActiveSaturationCounters[index] = Converters[index].countSaturated;
+
+        return EntryPoints[index];
+    }
+
+    ConverterRegistration::ConverterRegistration(
+        const char* sourceFormat,
+        const char* targetFormat,
+        const SoapySDR::ConverterRegistry::FunctionPriority priority,
+        SoapySDR::ConverterRegistry::ConverterFunction function,
+        const char* kernels):
+        _registry(
+            sourceFormat,
+            targetFormat,
+            priority,
+            addConverter(sourceFormat, targetFormat, priority, function, kernels))
+    {
+    }
+
+    std::vector<ConverterDescription> getConverterDescriptions()
+    {
+        std::vector<ConverterDescription> descriptions;
+        for(size_t i = 0; i < NumConverters; ++i)
+        {
+            const auto& converter = Converters[i];
+            descriptions.push_back(ConverterDescription{
+                converter.sourceFormat,
+                converter.targetFormat,
+                converter.priority,
+                converter.kernels});
+        }
+
+        return descriptions;
+    }
+
+    //
+    // Configuration
+    //
+
+    static bool getEnvFlag(const char* name, const bool defaultValue)
+    {
+        const char* value = std::getenv(name);
+        if(!value || !value[0]) return defaultValue;
+
+        return (0 != std::strcmp(value, "0")) && (0 != std::strcmp(value, "false"));
+    }
+
+    void initStats()
+    {
+        StatsEnabled = getEnvFlag("SOAPY_VOLK_STATS", true);
+        VOLKAlignmentMask = volk_get_alignment() - 1;
+        LogStatsOnUnload = getEnvFlag("SOAPY_VOLK_STATS_LOG", false);
+        StageTimingEnabled = getEnvFlag("SOAPY_VOLK_STAGE_TIMING", false);
+
+        const char* latencyCSVPath = std::getenv("SOAPY_VOLK_LATENCY_CSV");
+        if(latencyCSVPath) getLatencyCSVPath() = latencyCSVPath;
+    }
+
+    static void logStats()
+    {
+        const double ticksPerNs = getTicksPerNanosecond();
+        const auto totals = getTotals();
+        for(size_t i = 0; i < NumConverters; ++i)
+        {
+            if(totals[i].calls == 0) continue;
+
+            const auto& converter = Converters[i];
+            SoapySDR::logf(
+                SOAPY_SDR_INFO,
+                "SoapyVOLKConverters: %s -> %s (priority %d): %llu calls, %llu elements, %llu bytes, %.3f ms",
+                converter.sourceFormat,
+                converter.targetFormat,
+                int(converter.priority),
+                (unsigned long long)totals[i].calls,
+                (unsigned long long)totals[i].elements,
+                (unsigned long long)(totals[i].elements * converter.bytesPerElem),
+                (totals[i].ticks / ticksPerNs / 1e6));
+        }
+    }
+
+    struct UnloadStatsLogger
+    {
+        // Makes sure the path is destroyed after this is.
+        UnloadStatsLogger()
+        {
+            getLatencyCSVPath();
+        }
+
+        ~UnloadStatsLogger()
+        {
+            if(LogStatsOnUnload) logStats();
+
+            const auto& latencyCSVPath = getLatencyCSVPath();
+            if(!latencyCSVPath.empty())
+            {
+                const int err = SoapyVOLKConverters_exportLatencyHistograms(latencyCSVPath.c_str());
+                if(err != 0)
+                {
+                    SoapySDR::logf(
+                        SOAPY_SDR_ERROR,
+                        "SoapyVOLKConverters: failed to write %s: %s",
+                        latencyCSVPath.c_str(),
+                        std::strerror(err));
+                }
+            }
+        }
+    };
+
+    static const UnloadStatsLogger UnloadLogger;
+}
+
+//
+// Exported API
+//
+
+using namespace SoapyVOLKConverters;
+
+size_t SoapyVOLKConverters_getStats(SoapyVOLKConvertersStats* stats, size_t maxStats)
+{
+    const double ticksPerNs = (maxStats > 0) ? getTicksPerNanosecond() : 1.0;
+    const auto totals = getTotals();
+    for(size_t i = 0; i < std::min(maxStats, NumConverters); ++i)
+    {
+        const auto& converter = Converters[i];
+        stats[i] = SoapyVOLKConvertersStats{
+            converter.sourceFormat,
+            converter.targetFormat,
+            int(converter.priority),
+            totals[i].calls,
+            totals[i].elements,
+            (totals[i].elements * converter.bytesPerElem),
+            uint64_t(totals[i].ticks / ticksPerNs),
+            totals[i].unalignedCalls,
+            totals[i].smallBufferCalls,
+            totals[i].zeroSkipCalls,
+            totals[i].saturatedSamples,
+            totals[i].stageTimedCalls,
+            uint64_t(totals[i].stageTicks[AllocStage] / ticksPerNs),
+            uint64_t(totals[i].stageTicks[FirstStage] / ticksPerNs),
+            uint64_t(totals[i].stageTicks[SecondStage] / ticksPerNs),
+            totals[i].allocations,
+            totals[i].allocatedBytes,
+            PeakScratchBytes[i].load(std::memory_order_relaxed)};
+    }
+
+    return NumConverters;
+}
+
+SoapySDR::ConverterRegistry::ConverterFunction SoapyVOLKConverters_getConverter(
+    const char* sourceFormat,
+    const char* targetFormat,
+    int priority)
+{
+    for(size_t i = 0; i < NumConverters; ++i)
+    {
+        const auto& converter = Converters[i];
+        if((0 == std::strcmp(converter.sourceFormat, sourceFormat)) &&
+           (0 == std::strcmp(converter.targetFormat, targetFormat)) &&
+           (int(converter.priority) == priority))
+        {
+            return EntryPoints[i];
+        }
+    }
+
+    return nullptr;
+}
+
+void SoapyVOLKConverters_resetStats(void)
+{
+    auto& registry = getCountersRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    registry.baseline = sumCounters(registry);
+    for(size_t i = 0; i < NumConverters; ++i)
+    {
+        registry.baselineHistograms[i].reset(new LatencyHistogramTotals(sumLatencyHistograms(registry, i)));
+        PeakScratchBytes[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void SoapyVOLKConverters_setStatsEnabled(bool enabled)
+{
+    StatsEnabled = enabled;
+}
+
+bool SoapyVOLKConverters_getStatsEnabled(void)
+{
+    return StatsEnabled;
+}
+
+void SoapyVOLKConverters_setLogStatsOnUnload(bool enabled)
+{
+    LogStatsOnUnload = enabled;
+}
+
+void SoapyVOLKConverters_setSaturationCountingEnabled(bool enabled)
+{
+    SaturationCountingEnabled = enabled;
+    for(size_t i = 0; i < NumConverters; ++i)
+    {
+        ActiveSaturationCounters[i] = enabled ? Converters[i].countSaturated : nullptr;
+    }
+}
+
+bool SoapyVOLKConverters_getSaturationCountingEnabled(void)
+{
+    return SaturationCountingEnabled;
+}
+
+void SoapyVOLKConverters_setStageTimingEnabled(bool enabled)
+{
+    StageTimingEnabled = enabled;
+}
+
+size_t SoapyVOLKConverters_getNumSizeClasses(void)
+{
+    return NumSizeClasses;
+}
+
+size_t SoapyVOLKConverters_getSizeClassMinElems(size_t sizeClass)
+{
+    return getSizeClassMinElems(sizeClass);
+}
+
+size_t SoapyVOLKConverters_getNumLatencyBuckets(void)
+{
+    return NumLatencyBuckets;
+}
+
+double SoapyVOLKConverters_getLatencyBucketMinNs(size_t bucket)
+{
+    return getLatencyBucketMinTicks(bucket) / getTicksPerNanosecond();
+}
+
+bool SoapyVOLKConverters_getLatencyHistogram(size_t converter, size_t sizeClass, uint64_t* counts)
+{
+    if((converter >= NumConverters) || (sizeClass >= NumSizeClasses)) return false;
+
+    const auto totals = getLatencyHistogramTotals(converter);
+    std::copy(totals.counts[sizeClass].begin(), totals.counts[sizeClass].end(), counts);
+
+    return true;
+}
+
+double SoapyVOLKConverters_getLatencyQuantileNs(size_t converter, size_t sizeClass, double quantile)
+{
+    if((converter >= NumConverters) || ((sizeClass >= NumSizeClasses) && (sizeClass != AllSizeClasses))) return NAN;
+
+    const auto totals = getLatencyHistogramTotals(converter);
+
+    std::array<uint64_t, NumLatencyBuckets> counts{};
+    for(size_t i = 0; i < NumSizeClasses; ++i)
+    {
+        if((sizeClass != AllSizeClasses) && (sizeClass != i)) continue;
+        for(size_t bucket = 0; bucket < NumLatencyBuckets; ++bucket) counts[bucket] += totals.counts[i][bucket];
+    }
+
+    uint64_t total = 0;
+    for(const auto count: counts) total += count;
+    if(total == 0) return NAN;
+
+    // Report the top of the bucket, so quantiles are never understated.
+    const uint64_t rank = std::max<uint64_t>(1, uint64_t(std::ceil(std::min(std::max(quantile, 0.0), 1.0) * total)));
+    uint64_t cumulative = 0;
+    size_t bucket = 0;
+    for(; bucket < (NumLatencyBuckets - 1); ++bucket)
+    {
+        cumulative += counts[bucket];
+        if(cumulative >= rank) break;
+    }
+
+    return getLatencyBucketMinTicks(bucket + 1) / getTicksPerNanosecond();
+}
+
+int SoapyVOLKConverters_exportLatencyHistograms(const char* path)
+{
+    std::unique_ptr<FILE, int(*)(FILE*)> file(std::fopen(path, "w"), &std::fclose);
+    if(!file) return errno;
+
+    const double ticksPerNs = getTicksPerNanosecond();
+
+    std::fprintf(file.get(), "source,target,priority,min_elems,min_ns,max_ns,count\n");
+    for(size_t i = 0; i < NumConverters; ++i)
+    {
+        const auto& converter = Converters[i];
+        const auto totals = getLatencyHistogramTotals(i);
+
+        for(size_t sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+        {
+            for(size_t bucket = 0; bucket < NumLatencyBuckets; ++bucket)
+            {
+                const uint64_t count = totals.counts[sizeClass][bucket];
+                if(count == 0) continue;
+
+                std::fprintf(
+                    file.get(),
+                    "%s,%s,%d,%zu,%.1f,%.1f,%llu\n",
+                    converter.sourceFormat,
+                    converter.targetFormat,
+                    int(converter.priority),
+                    getSizeClassMinElems(sizeClass),
+                    (getLatencyBucketMinTicks(bucket) / ticksPerNs),
+                    (getLatencyBucketMinTicks(bucket + 1) / ticksPerNs),
+                    (unsigned long long)count);
+            }
+        }
+    }
+
+    return std::ferror(file.get()) ? EIO : 0;
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <SoapySDR/ConverterRegistry.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace SoapyVOLKConverters
+{
+    //
+    // Registers a converter with SoapySDR through a per-converter entry point,
+    // which records statistics for each call before passing it on.
+    //
+    // Formats and kernels must be string literals, as they're referenced for
+    // the lifetime of the module. Kernels are the comma-separated VOLK
+    // kernels the converter calls, if any.
+    //
+    class ConverterRegistration
+    {
+    public:
+        ConverterRegistration(
+            const char* sourceFormat,
+            const char* targetFormat,
+            const SoapySDR::ConverterRegistry::FunctionPriority priority,
+            SoapySDR::ConverterRegistry::ConverterFunction function,
+            const char* kernels = nullptr);
+
+    private:
+        SoapySDR::ConverterRegistry _registry;
+    };
+
+    struct ConverterDescription
+    {
+        const char* sourceFormat;
+        const char* targetFormat;
+        SoapySDR::ConverterRegistry::FunctionPriority priority;
+        const char* kernels;
+    };
+
+    // Every converter recorded, in registration order
+    std::vector<ConverterDescription> getConverterDescriptions();
+
+    // Configures statistics from SOAPY_VOLK_STATS and SOAPY_VOLK_STATS_LOG.
+    void initStats();
+
+    // Called by converters that zero-skipped any blocks, and counted against
+    // the converter being called on this thread.
+    void countZeroSkipCall();
+
+    // Called by converters that allocate scratch memory, and counted against
+    // the converter being called on this thread.
+    void countScratchAllocation(const size_t bytes);
+
+    enum ConverterStage
+    {
+        AllocStage,
+        FirstStage,
+        SecondStage,
+        NumConverterStages
+    };
+
+    //
+    // Times the stages of a converter that allocates an intermediate buffer
+    // and calls two kernels, counted against the converter being called on
+    // this thread. Only reads the clock while stage timing is enabled.
+    //
+    // Declare it before the buffer, so the buffer is freed first, and the
+    // time from the last stage to the timer's destruction is counted as
+    // allocation.
+    //
+    class StageTimer
+    {
+    public:
+        StageTimer();
+
+        ~StageTimer();
+
+        // Ends the given stage, and starts the next.
+        void endStage(const ConverterStage stage);
+
+    private:
+        uint64_t _lastTicks{0};
+        bool _enabled{false};
+    };
+}
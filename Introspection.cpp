@@ -0,0 +1,225 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#include "Instrumentation.hpp"
+#include "SoapyVOLKConverters.hpp"
+
+#include <volk/volk.h>
+#include <volk/volk_prefs.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace SoapyVOLKConverters
+{
+    struct KernelDescriptor
+    {
+        const char* name;
+        volk_func_desc_t (*getFuncDesc)(void);
+    };
+
+    // Every kernel a converter calls
+    static const KernelDescriptor Kernels[] =
+    {
+        {"volk_8i_convert_16i", &volk_8i_convert_16i_get_func_desc},
+        {"volk_16i_convert_8i", &volk_16i_convert_8i_get_func_desc},
+        {"volk_8i_s32f_convert_32f", &volk_8i_s32f_convert_32f_get_func_desc},
+        {"volk_16i_s32f_convert_32f", &volk_16i_s32f_convert_32f_get_func_desc},
+        {"volk_32i_s32f_convert_32f", &volk_32i_s32f_convert_32f_get_func_desc},
+        {"volk_32f_s32f_convert_8i", &volk_32f_s32f_convert_8i_get_func_desc},
+        {"volk_32f_s32f_convert_16i", &volk_32f_s32f_convert_16i_get_func_desc},
+        {"volk_32f_s32f_convert_32i", &volk_32f_s32f_convert_32i_get_func_desc},
+        {"volk_32f_s32f_multiply_32f", &volk_32f_s32f_multiply_32f_get_func_desc},
+        {"volk_32f_convert_64f", &volk_32f_convert_64f_get_func_desc},
+        {"volk_64f_convert_32f", &volk_64f_convert_32f_get_func_desc},
+    };
+
+    //
+    // VOLK's dispatch, as in volk_rank_archs(): VOLK_GENERIC forces the
+    // generic implementation, then the config file written by volk_profile
+    // is checked, then the available implementation with the most
+    // architecture dependencies wins.
+    //
+
+    struct VOLKPreferences
+    {
+        std::string configPath;
+        volk_arch_pref_t* prefs{nullptr};
+        size_t numPrefs{0};
+    };
+
+    static const VOLKPreferences& getVOLKPreferences()
+    {
+        static const VOLKPreferences preferences = []()
+        {
+            VOLKPreferences prefs;
+
+            char path[512] = {0};
+            volk_get_config_path(path, true);
+            prefs.configPath = path;
+
+            // Allocated by VOLK and kept for the lifetime of the module
+            prefs.numPrefs = volk_load_preferences(&prefs.prefs);
+
+            return prefs;
+        }();
+
+        return preferences;
+    }
+
+    static const char* findImpl(const volk_func_desc_t& desc, const char* name)
+    {
+        for(size_t i = 0; i < desc.n_impls; ++i)
+        {
+            if(0 == std::strcmp(desc.impl_names[i], name)) return desc.impl_names[i];
+        }
+
+        return nullptr;
+    }
+
+    static size_t countDeps(int deps)
+    {
+        size_t count = 0;
+        for(; deps != 0; deps &= (deps - 1)) ++count;
+
+        return count;
+    }
+
+    static const char* getBestImpl(const volk_func_desc_t& desc, const bool aligned)
+    {
+        const char* bestAligned = nullptr;
+        const char* bestUnaligned = nullptr;
+        size_t bestAlignedDeps = 0;
+        size_t bestUnalignedDeps = 0;
+
+        for(size_t i = 0; i < desc.n_impls; ++i)
+        {
+            const size_t deps = countDeps(desc.impl_deps[i]);
+            if(desc.impl_alignment[i] && (!bestAligned || (deps > bestAlignedDeps)))
+            {
+                bestAligned = desc.impl_names[i];
+                bestAlignedDeps = deps;
+            }
+            if(!desc.impl_alignment[i] && (!bestUnaligned || (deps > bestUnalignedDeps)))
+            {
+                bestUnaligned = desc.impl_names[i];
+                bestUnalignedDeps = deps;
+            }
+        }
+
+        return (aligned && bestAligned) ? bestAligned : bestUnaligned;
+    }
+
+    struct KernelSelection
+    {
+        const char* kernel;
+        const char* alignedImpl;
+        const char* unalignedImpl;
+        const char* selectedBy;
+    };
+
+    static KernelSelection selectImpls(const KernelDescriptor& kernel)
+    {
+        const auto desc = kernel.getFuncDesc();
+
+        if(std::getenv("VOLK_GENERIC"))
+        {
+            const char* generic = findImpl(desc, "generic");
+            return KernelSelection{kernel.name, generic, generic, "VOLK_GENERIC"};
+        }
+
+        const auto& preferences = getVOLKPreferences();
+        for(size_t i = 0; i < preferences.numPrefs; ++i)
+        {
+            const auto& pref = preferences.prefs[i];
+            if(0 != std::strncmp(kernel.name, pref.name, sizeof(pref.name))) continue;
+
+            // VOLK falls back to generic for implementations that aren't
+            // available on this machine.
+            const char* generic = findImpl(desc, "generic");
+            const char* alignedImpl = findImpl(desc, pref.impl_a);
+            const char* unalignedImpl = findImpl(desc, pref.impl_u);
+
+            return KernelSelection{
+                kernel.name,
+                alignedImpl ? alignedImpl : generic,
+                unalignedImpl ? unalignedImpl : generic,
+                "config"};
+        }
+
+        return KernelSelection{kernel.name, getBestImpl(desc, true), getBestImpl(desc, false), "default"};
+    }
+
+    static const KernelSelection* getKernelSelection(const std::string& name)
+    {
+        static const std::vector<KernelSelection> selections = []()
+        {
+            std::vector<KernelSelection> kernelSelections;
+            for(const auto& kernel: Kernels) kernelSelections.push_back(selectImpls(kernel));
+
+            return kernelSelections;
+        }();
+
+        for(const auto& selection: selections)
+        {
+            if(name == selection.kernel) return &selection;
+        }
+
+        return nullptr;
+    }
+}
+
+//
+// Exported API
+//
+
+using namespace SoapyVOLKConverters;
+
+size_t SoapyVOLKConverters_getKernelInfo(SoapyVOLKConvertersKernelInfo* info, size_t maxInfo)
+{
+    static const KernelSelection NoKernel{"", "", "", ""};
+
+    size_t numInfo = 0;
+    for(const auto& converter: getConverterDescriptions())
+    {
+        std::vector<const KernelSelection*> selections;
+
+        const std::string kernels = converter.kernels ? converter.kernels : "";
+        for(size_t start = 0; start < kernels.size();)
+        {
+            size_t end = kernels.find(',', start);
+            if(end == std::string::npos) end = kernels.size();
+
+            const auto* selection = getKernelSelection(kernels.substr(start, (end - start)));
+            if(selection) selections.push_back(selection);
+
+            start = end + 1;
+        }
+        if(selections.empty()) selections.push_back(&NoKernel);
+
+        for(const auto* selection: selections)
+        {
+            if(numInfo < maxInfo)
+            {
+                info[numInfo] = SoapyVOLKConvertersKernelInfo{
+                    converter.sourceFormat,
+                    converter.targetFormat,
+                    int(converter.priority),
+                    selection->kernel,
+                    selection->alignedImpl ? selection->alignedImpl : "",
+                    selection->unalignedImpl ? selection->unalignedImpl : "",
+                    selection->selectedBy};
+            }
+            ++numInfo;
+        }
+    }
+
+    return numInfo;
+}
+
+const char* SoapyVOLKConverters_getVOLKConfigPath(void)
+{
+    return getVOLKPreferences().configPath.c_str();
+}
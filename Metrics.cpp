@@ -0,0 +1,363 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#include "Metrics.hpp"
+#include "SoapyVOLKConverters.hpp"
+
+#include <SoapySDR/Logger.hpp>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SoapyVOLKConverters
+{
+    //
+    // Prometheus text format
+    //
+
+    static const double LatencyQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+    static void writeHeader(std::ostream& out, const char* name, const char* type, const char* help)
+    {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+    }
+
+    static void writeLabels(std::ostream& out, const SoapyVOLKConvertersStats& stats)
+    {
+        out << "source=\"" << stats.sourceFormat << "\",target=\"" << stats.targetFormat
+            << "\",priority=\"" << stats.priority << "\"";
+    }
+
+    template <typename ValueFcn>
+    static void writeCounter(
+        std::ostream& out,
+        const std::vector<SoapyVOLKConvertersStats>& allStats,
+        const char* name,
+        const char* help,
+        ValueFcn getValue)
+    {
+        writeHeader(out, name, "counter", help);
+        for(const auto& stats: allStats)
+        {
+            out << name << "{";
+            writeLabels(out, stats);
+            out << "} " << getValue(stats) << "\n";
+        }
+    }
+
+    static std::string formatMetrics()
+    {
+        std::vector<SoapyVOLKConvertersStats> allStats(SoapyVOLKConverters_getStats(nullptr, 0));
+        SoapyVOLKConverters_getStats(allStats.data(), allStats.size());
+
+        std::ostringstream out;
+        out.imbue(std::locale::classic());
+
+        writeCounter(out, allStats, "soapy_volk_converter_calls_total", "Converter calls.",
+            [](const SoapyVOLKConvertersStats& stats) { return stats.calls; });
+        writeCounter(out, allStats, "soapy_volk_converter_elements_total", "Elements converted.",
+            [](const SoapyVOLKConvertersStats& stats) { return stats.elements; });
+        writeCounter(out, allStats, "soapy_volk_converter_bytes_total", "Bytes read and written by converters.",
+            [](const SoapyVOLKConvertersStats& stats) { return stats.bytes; });
+        if(SoapyVOLKConverters_getSaturationCountingEnabled())
+        {
+            writeCounter(out, allStats, "soapy_volk_converter_saturated_samples_total", "Float to integer outputs at the integer limits.",
+                [](const SoapyVOLKConvertersStats& stats) { return stats.saturatedSamples; });
+        }
+
+        static const char* FallbackCallsName = "soapy_volk_converter_fallback_calls_total";
+        writeHeader(out, FallbackCallsName, "counter", "Converter calls that took a slower path.");
+        for(const auto& stats: allStats)
+        {
+            const std::pair<const char*, uint64_t> paths[] =
+            {
+                {"unaligned", stats.unalignedCalls},
+                {"small_buffer", stats.smallBufferCalls}
+            };
+            for(const auto& path: paths)
+            {
+                out << FallbackCallsName << "{";
+                writeLabels(out, stats);
+                out << ",path=\"" << path.first << "\"} " << path.second << "\n";
+            }
+        }
+
+        writeCounter(out, allStats, "soapy_volk_converter_zero_skip_calls_total", "Converter calls that filled all-zero input blocks instead of converting them.",
+            [](const SoapyVOLKConvertersStats& stats) { return stats.zeroSkipCalls; });
+
+        static const char* LatencyName = "soapy_volk_converter_latency_seconds";
+        writeHeader(out, LatencyName, "summary", "Converter call latency.");
+        for(size_t i = 0; i < allStats.size(); ++i)
+        {
+            const auto& stats = allStats[i];
+            for(const double quantile: LatencyQuantiles)
+            {
+                const double latencyNs = SoapyVOLKConverters_getLatencyQuantileNs(i, AllSizeClasses, quantile);
+
+                out << LatencyName << "{";
+                writeLabels(out, stats);
+                out << ",quantile=\"" << quantile << "\"} ";
+                if(std::isnan(latencyNs)) out << "NaN\n";
+                else out << (latencyNs / 1e9) << "\n";
+            }
+
+            out << LatencyName << "_sum{";
+            writeLabels(out, stats);
+            out << "} " << (stats.nanoseconds / 1e9) << "\n";
+
+            out << LatencyName << "_count{";
+            writeLabels(out, stats);
+            out << "} " << stats.calls << "\n";
+        }
+
+        writeHeader(out, "soapy_volk_zero_skip_blocks_total", "counter", "Zero input blocks filled instead of converted.");
+        out << "soapy_volk_zero_skip_blocks_total " << SoapyVOLKConverters_getZeroSkipBlockCount() << "\n";
+
+        return out.str();
+    }
+
+    //
+    // Publishing
+    //
+
+#ifndef _WIN32
+    static void lowerThreadPriority()
+    {
+#ifdef __linux__
+        sched_param param{};
+        pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#else
+        sched_param param{};
+        param.sched_priority = sched_get_priority_min(SCHED_OTHER);
+        pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+#endif
+    }
+
+    // Writes the metrics to a file, or serves them to each connection to a
+    // UNIX socket, refreshing them from a low-priority thread.
+    class MetricsPublisher
+    {
+    public:
+        MetricsPublisher(const std::string& target, const std::chrono::milliseconds interval):
+            _interval(interval)
+        {
+            static const std::string SocketPrefix = "unix:";
+            if(target.compare(0, SocketPrefix.size(), SocketPrefix) == 0)
+            {
+                _socketPath = target.substr(SocketPrefix.size());
+                _listen();
+            }
+            else _filePath = target;
+
+            _thread = std::thread(&MetricsPublisher::_run, this);
+        }
+
+        ~MetricsPublisher()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _cond.notify_all();
+            _thread.join();
+
+            if(_listenFd >= 0)
+            {
+                ::close(_listenFd);
+                ::unlink(_socketPath.c_str());
+            }
+        }
+
+    private:
+        std::chrono::milliseconds _interval;
+        std::string _filePath;
+        std::string _socketPath;
+        int _listenFd{-1};
+
+        std::mutex _mutex;
+        std::condition_variable _cond;
+        bool _stop{false};
+        std::thread _thread;
+
+        void _listen()
+        {
+            sockaddr_un addr{};
+            addr.sun_family = AF_UNIX;
+            if(_socketPath.size() >= sizeof(addr.sun_path)) throw std::runtime_error("socket path too long");
+            std::strcpy(addr.sun_path, _socketPath.c_str());
+
+            _listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if(_listenFd < 0) throw std::runtime_error(std::strerror(errno));
+
+            // Replace a socket left behind by an earlier process.
+            ::unlink(_socketPath.c_str());
+            if((::bind(_listenFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0) || (::listen(_listenFd, 4) < 0))
+            {
+                const int err = errno;
+                ::close(_listenFd);
+                _listenFd = -1;
+                throw std::runtime_error(std::strerror(err));
+            }
+        }
+
+        void _writeFile(const std::string& metrics)
+        {
+            // Written to a temporary file and renamed, so scrapers never see
+            // a partial file.
+            const std::string tmpPath = _filePath + ".tmp";
+            std::unique_ptr<FILE, int(*)(FILE*)> file(std::fopen(tmpPath.c_str(), "w"), &std::fclose);
+            if(!file) return;
+
+            const bool written = (std::fwrite(metrics.data(), 1, metrics.size(), file.get()) == metrics.size());
+            file.reset();
+
+            if(written) std::rename(tmpPath.c_str(), _filePath.c_str());
+        }
+
+        // Returns false once stopped.
+        bool _wait(const std::chrono::steady_clock::time_point until)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait_until(lock, until, [this]{ return _stop; });
+
+            return !_stop;
+        }
+
+        void _serve(const std::string& metrics, const std::chrono::steady_clock::time_point until)
+        {
+            // Polls in short steps, so unloading the module isn't held up.
+            static constexpr int PollStepMs = 100;
+
+            while(std::chrono::steady_clock::now() < until)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if(_stop) return;
+                }
+
+                pollfd fd{_listenFd, POLLIN, 0};
+                if(::poll(&fd, 1, PollStepMs) <= 0) continue;
+
+                const int clientFd = ::accept(_listenFd, nullptr, nullptr);
+                if(clientFd < 0) continue;
+
+                size_t sent = 0;
+                while(sent < metrics.size())
+                {
+                    const auto ret = ::send(clientFd, metrics.data() + sent, metrics.size() - sent, MSG_NOSIGNAL);
+                    if(ret <= 0) break;
+                    sent += size_t(ret);
+                }
+                ::close(clientFd);
+            }
+        }
+
+        void _run()
+        {
+            lowerThreadPriority();
+
+            // The thread starts while the module is loading, so wait before
+            // reading anything.
+            auto next = std::chrono::steady_clock::now() + _interval;
+            if(!_wait(next)) return;
+
+            while(true)
+            {
+                const auto metrics = formatMetrics();
+                next += _interval;
+
+                if(_listenFd >= 0) _serve(metrics, next);
+                else _writeFile(metrics);
+
+                if(!_wait(next)) break;
+            }
+
+            // Leave the final counts behind.
+            if(!_filePath.empty()) _writeFile(formatMetrics());
+        }
+    };
+
+    // Set from the module's initializer, which may run before this file's
+    // dynamic initializers.
+    static std::unique_ptr<MetricsPublisher>& getMetricsPublisher()
+    {
+        static std::unique_ptr<MetricsPublisher> publisher;
+        return publisher;
+    }
+#endif
+
+    void initMetrics()
+    {
+        const char* target = std::getenv("SOAPY_VOLK_METRICS");
+        if(!target || !target[0]) return;
+
+#ifdef _WIN32
+        SoapySDR::log(SOAPY_SDR_WARNING, "SoapyVOLKConverters: SOAPY_VOLK_METRICS isn't supported on this platform");
+#else
+        const char* intervalMs = std::getenv("SOAPY_VOLK_METRICS_INTERVAL_MS");
+        const auto interval = std::chrono::milliseconds(std::max(100L, intervalMs ? std::strtol(intervalMs, nullptr, 10) : 5000L));
+
+        try
+        {
+            getMetricsPublisher().reset(new MetricsPublisher(target, interval));
+
+            const char* saturation = std::getenv("SOAPY_VOLK_METRICS_SATURATION");
+            if(saturation && saturation[0] && (0 != std::strcmp(saturation, "0")) && (0 != std::strcmp(saturation, "false")))
+            {
+                SoapyVOLKConverters_setSaturationCountingEnabled(true);
+            }
+
+            SoapySDR::logf(SOAPY_SDR_INFO, "SoapyVOLKConverters: publishing metrics to %s", target);
+        }
+        catch(const std::exception& ex)
+        {
+            SoapySDR::logf(SOAPY_SDR_ERROR, "SoapyVOLKConverters: failed to publish metrics to %s: %s", target, ex.what());
+        }
+#endif
+    }
+}
+
+//
+// Exported API
+//
+
+size_t SoapyVOLKConverters_getMetricsText(char* text, size_t maxLength)
+{
+    const auto metrics = SoapyVOLKConverters::formatMetrics();
+    if(maxLength > 0)
+    {
+        const size_t length = std::min(metrics.size(), (maxLength - 1));
+        std::memcpy(text, metrics.data(), length);
+        text[length] = '\0';
+    }
+
+    return metrics.size();
+}
@@ -0,0 +1,13 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+namespace SoapyVOLKConverters
+{
+    // Starts publishing metrics if SOAPY_VOLK_METRICS is set to a file path,
+    // or to "unix:" followed by a socket path. SOAPY_VOLK_METRICS_INTERVAL_MS
+    // sets how often they're refreshed, and SOAPY_VOLK_METRICS_SATURATION=1
+    // enables saturation counting.
+    void initMetrics();
+}
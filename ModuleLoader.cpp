@@ -0,0 +1,125 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#include "config.h"
+#include "ModuleLoader.hpp"
+
+#include <SoapySDR/Modules.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+#if defined _WIN32 || defined __CYGWIN__
+#define IS_WIN32
+
+#include <direct.h> // _getcwd
+#define NOMINMAX
+#include <windows.h> // GetModuleHandleA, GetProcAddress
+
+#define getcwd _getcwd
+#else
+#define IS_UNIX
+
+#include <dlfcn.h> // dlopen, dlsym
+#include <unistd.h> // getcwd
+#endif
+
+#ifndef MAX_PATH
+#define MAX_PATH 256
+#endif
+
+// TODO: MinGW
+namespace ModuleLoader
+{
+    static std::string modulePath;
+
+    static std::string getBuildModulePath()
+    {
+        std::string basename;
+        std::string extension;
+        std::string separator;
+        std::string subpath;
+
+        char cwd[MAX_PATH] = {0};
+        char* _ = getcwd(cwd, sizeof(cwd)); // Suppress Clang warning
+        (void)_;
+
+#ifdef IS_WIN32
+        basename = "volkConverters";
+        extension = ".dll";
+        separator = "\\";
+        subpath = cwd + separator + CMAKE_BUILD_TYPE;
+#else
+        basename = "libvolkConverters";
+        extension = ".so";
+        separator = "/";
+        subpath.assign(cwd);
+#endif
+
+        return subpath + separator + basename + extension;
+    }
+
+    static bool loadModule(const std::string& filepath)
+    {
+        try
+        {
+            std::cout << "Loading " << filepath << "..." << std::endl;
+            SoapySDR::loadModule(filepath);
+            std::cout << "Loaded version " << SoapySDR::getModuleVersion(filepath) << std::endl;
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "Exception loading module: " << ex.what() << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool loadSoapyVOLK(const std::string& path)
+    {
+        return loadSoapyVOLK(std::vector<std::string>{path});
+    }
+
+    bool loadSoapyVOLK(const std::vector<std::string>& paths)
+    {
+        for (const auto& path: paths)
+        {
+            const std::string filepath = path.empty() ? getBuildModulePath() : path;
+            if (!loadModule(filepath)) return false;
+
+            if (modulePath.empty()) modulePath = filepath;
+        }
+
+        return true;
+    }
+
+    std::string getModulePath()
+    {
+        return modulePath;
+    }
+
+    void* getModuleSymbol(const std::string& name)
+    {
+        if (modulePath.empty()) throw std::runtime_error("getModuleSymbol: module not loaded");
+
+        return getModuleSymbol(modulePath, name);
+    }
+
+    void* getModuleSymbol(const std::string& path, const std::string& name)
+    {
+        // SoapySDR has already loaded the module, so these just find the
+        // existing handle.
+#ifdef IS_WIN32
+        HMODULE handle = GetModuleHandleA(path.c_str());
+        void* symbol = handle ? reinterpret_cast<void*>(GetProcAddress(handle, name.c_str())) : nullptr;
+#else
+        void* handle = dlopen(path.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+        void* symbol = handle ? dlsym(handle, name.c_str()) : nullptr;
+        if (handle) dlclose(handle);
+#endif
+        if (!symbol) throw std::runtime_error("getModuleSymbol: " + name + " not found in " + path);
+
+        return symbol;
+    }
+}
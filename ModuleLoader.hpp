@@ -0,0 +1,48 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Looks up a function declared in SoapyVOLKConverters.hpp in the loaded module
+#define GET_MODULE_FUNCTION(name) ModuleLoader::getModuleFunction<decltype(name)>(#name)
+
+// The same, in the module loaded from the given path
+#define GET_MODULE_FUNCTION_FROM(path, name) ModuleLoader::getModuleFunction<decltype(name)>(path, #name)
+
+// Loads the module through SoapySDR and finds its exported functions, for the
+// tests, benchmark, and tools. Only depends on SoapySDR.
+namespace ModuleLoader
+{
+    // Loads the module from the build directory, or from the given path
+    bool loadSoapyVOLK(const std::string& path = "");
+
+    // Loads a module from each path, such as two builds to compare. SoapySDR
+    // keeps the converters of the first, which getModulePath() returns, and
+    // the others' are only reachable through SoapyVOLKConverters_getConverter.
+    // An empty path is the build directory's module.
+    bool loadSoapyVOLK(const std::vector<std::string>& paths);
+
+    // The path the module was loaded from
+    std::string getModulePath();
+
+    // Throws if the loaded module doesn't export the given symbol
+    void* getModuleSymbol(const std::string& name);
+
+    // The same, from one of the modules loaded from the given paths
+    void* getModuleSymbol(const std::string& path, const std::string& name);
+
+    template <typename Fcn>
+    Fcn* getModuleFunction(const std::string& name)
+    {
+        return reinterpret_cast<Fcn*>(getModuleSymbol(name));
+    }
+
+    template <typename Fcn>
+    Fcn* getModuleFunction(const std::string& path, const std::string& name)
+    {
+        return reinterpret_cast<Fcn*>(getModuleSymbol(path, name));
+    }
+}
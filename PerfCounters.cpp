@@ -0,0 +1,143 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#include "PerfCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+struct CounterConfig
+{
+    uint32_t type;
+    uint64_t config;
+};
+
+static constexpr uint64_t cacheMissConfig(const uint64_t cache)
+{
+    return cache | (uint64_t(PERF_COUNT_HW_CACHE_OP_READ) << 8) | (uint64_t(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16);
+}
+
+static const CounterConfig CounterConfigs[PerfCounters::NumCounters] =
+{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cacheMissConfig(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, cacheMissConfig(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}
+};
+
+static int openCounter(const CounterConfig& config)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = config.type;
+    attr.config = config.config;
+    attr.disabled = 1;
+
+    // User space only, which is all the converters run in, and allowed at
+    // the default perf_event_paranoid level.
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+PerfCounters::PerfCounters()
+{
+    _fds.fill(-1);
+
+#ifdef __linux__
+    for (size_t i = 0; i < NumCounters; ++i)
+    {
+        _fds[i] = openCounter(CounterConfigs[i]);
+        if ((_fds[i] < 0) && _error.empty()) _error = std::string("perf_event_open: ") + std::strerror(errno);
+    }
+    if (available()) _error.clear();
+#else
+    _error = "hardware counters are only supported on Linux";
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (const int fd: _fds)
+    {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+bool PerfCounters::available() const
+{
+    for (const int fd: _fds)
+    {
+        if (fd >= 0) return true;
+    }
+
+    return false;
+}
+
+const std::string& PerfCounters::getError() const
+{
+    return _error;
+}
+
+const char* PerfCounters::getName(const Counter counter)
+{
+    static const char* Names[NumCounters] = {"cycles", "instructions", "L1D misses", "LLC misses", "branch misses"};
+    return Names[counter];
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+    for (const int fd: _fds)
+    {
+        if (fd < 0) continue;
+
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+PerfCounters::Counts PerfCounters::stop()
+{
+    Counts counts;
+    counts.fill(NAN);
+
+#ifdef __linux__
+    for (const int fd: _fds)
+    {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    for (size_t i = 0; i < NumCounters; ++i)
+    {
+        if (_fds[i] < 0) continue;
+
+        // Value, time enabled, time running
+        uint64_t values[3] = {0, 0, 0};
+        if (read(_fds[i], values, sizeof(values)) != ssize_t(sizeof(values))) continue;
+        if (values[2] == 0) continue;
+
+        counts[i] = double(values[0]) * (double(values[1]) / double(values[2]));
+    }
+#endif
+
+    return counts;
+}
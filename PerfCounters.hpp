@@ -0,0 +1,54 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <array>
+#include <string>
+
+//
+// Hardware performance counters for the calling thread, read with Linux's
+// perf_event_open(). Each counter is opened separately, so any the kernel,
+// CPU, or container doesn't allow are just unavailable. Counts are scaled up
+// if the kernel multiplexed counters.
+//
+class PerfCounters
+{
+public:
+    enum Counter
+    {
+        Cycles,
+        Instructions,
+        L1DMisses,
+        LLCMisses,
+        BranchMisses,
+        NumCounters
+    };
+
+    // NaN for counters that aren't available
+    using Counts = std::array<double, NumCounters>;
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // True if any counter could be opened
+    bool available() const;
+
+    // Why counters aren't available, if they aren't
+    const std::string& getError() const;
+
+    static const char* getName(const Counter counter);
+
+    // Resets and enables every counter
+    void start();
+
+    // Disables every counter and returns its count since start()
+    Counts stop();
+
+private:
+    std::array<int, NumCounters> _fds;
+    std::string _error;
+};
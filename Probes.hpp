@@ -0,0 +1,30 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+//
+// USDT probes, for observing conversions with bpftrace, perf, or SystemTap
+// without restarting the process. Each is a single nop until a tracer
+// attaches. Without sys/sdt.h, they compile away entirely.
+//
+// Provider: soapy_volk
+//
+//  * convert_entry(source, target, numElems, scalarBits)
+//  * convert_exit(source, target, numElems, scalarBits)
+//
+// source and target are format strings. The scalar is passed as the bits of
+// its IEEE-754 double, since tracers can't reliably read floating-point
+// probe arguments.
+//
+
+#include "config.h"
+
+#ifdef HAVE_SYS_SDT_H
+#include <sys/sdt.h>
+
+#define SOAPY_VOLK_PROBE4(name, arg1, arg2, arg3, arg4) \
+    STAP_PROBE4(soapy_volk, name, arg1, arg2, arg3, arg4)
+#else
+#define SOAPY_VOLK_PROBE4(name, arg1, arg2, arg3, arg4)
+#endif
@@ -0,0 +1,638 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#include "config.h"
+#include "RecordingSink.hpp"
+
+#include <SoapySDR/Formats.hpp>
+#include <SoapySDR/Logger.hpp>
+
+#include <volk/volk.h>
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace SoapyVOLKConverters
+{
+    // Satisfies the offset, length, and memory alignment O_DIRECT requires
+    // on any device with a logical block size up to 4K.
+    static constexpr size_t DirectIOAlignment = 4096;
+
+    static size_t roundUp(const size_t value, const size_t alignment)
+    {
+        return ((value + alignment - 1) / alignment) * alignment;
+    }
+
+    static std::system_error systemError(const int err, const std::string& what)
+    {
+        return std::system_error(err, std::generic_category(), "RecordingSink: " + what);
+    }
+
+    //
+    // I/O backends
+    //
+
+    class IOBackend
+    {
+    public:
+        virtual ~IOBackend() = default;
+
+        virtual const char* name() const = 0;
+
+        // Queues a write of the given buffer. Ownership of the buffer passes
+        // to the backend until waitForCompletion() returns its index.
+        virtual void submit(
+            const size_t index,
+            const uint8_t* data,
+            const size_t size,
+            const uint64_t offset) = 0;
+
+        struct Completion
+        {
+            size_t index;
+            int error; // errno, or 0 if the write completed in full
+        };
+
+        // Blocks until a write completes in full or fails. Ownership of the
+        // buffer returns to the caller either way. Throws only if no
+        // completion could be read.
+        virtual Completion waitForCompletion() = 0;
+    };
+
+    static void pwriteAll(
+        const int fd,
+        const uint8_t* data,
+        size_t size,
+        uint64_t offset)
+    {
+        while(size > 0)
+        {
+            const auto ret = ::pwrite(fd, data, size, off_t(offset));
+            if(ret < 0)
+            {
+                if(errno == EINTR) continue;
+                throw systemError(errno, "pwrite failed");
+            }
+            else if(ret == 0) throw std::runtime_error("RecordingSink: pwrite wrote no bytes");
+
+            data += ret;
+            size -= size_t(ret);
+            offset += uint64_t(ret);
+        }
+    }
+
+    class ThreadPoolBackend: public IOBackend
+    {
+    public:
+        ThreadPoolBackend(const int fd, const size_t numThreads):
+            _fd(fd)
+        {
+            for(size_t i = 0; i < std::max<size_t>(numThreads, 1); ++i)
+            {
+                _threads.emplace_back(&ThreadPoolBackend::_workerLoop, this);
+            }
+        }
+
+        ~ThreadPoolBackend() override
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _done = true;
+            }
+            _jobCond.notify_all();
+            for(auto& thread: _threads) thread.join();
+        }
+
+        const char* name() const override
+        {
+            return "pwrite";
+        }
+
+        void submit(
+            const size_t index,
+            const uint8_t* data,
+            const size_t size,
+            const uint64_t offset) override
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _jobs.push_back(Job{index, data, size, offset});
+            }
+            _jobCond.notify_one();
+        }
+
+        Completion waitForCompletion() override
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _completionCond.wait(lock, [this]{ return !_completions.empty(); });
+
+            const auto completion = _completions.front();
+            _completions.pop_front();
+
+            return completion;
+        }
+
+    private:
+        struct Job
+        {
+            size_t index;
+            const uint8_t* data;
+            size_t size;
+            uint64_t offset;
+        };
+
+        void _workerLoop()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while(true)
+            {
+                _jobCond.wait(lock, [this]{ return _done || !_jobs.empty(); });
+                if(_jobs.empty()) return;
+
+                const auto job = _jobs.front();
+                _jobs.pop_front();
+                lock.unlock();
+
+                int error = 0;
+                try
+                {
+                    pwriteAll(_fd, job.data, job.size, job.offset);
+                }
+                catch(const std::system_error& ex)
+                {
+                    error = ex.code().value();
+                }
+                catch(...)
+                {
+                    error = EIO;
+                }
+
+                lock.lock();
+                _completions.push_back(Completion{job.index, error});
+                _completionCond.notify_one();
+            }
+        }
+
+        int _fd;
+        bool _done{false};
+
+        std::mutex _mutex;
+        std::condition_variable _jobCond;
+        std::condition_variable _completionCond;
+        std::deque<Job> _jobs;
+        std::deque<Completion> _completions;
+        std::vector<std::thread> _threads;
+    };
+
+#ifdef HAVE_LIBURING
+    class IOUringBackend: public IOBackend
+    {
+    public:
+        IOUringBackend(
+            const int fd,
+            const std::vector<uint8_t*>& buffers,
+            const size_t bufferSize):
+            _fd(fd),
+            _requests(buffers.size())
+        {
+            const int ret = io_uring_queue_init(unsigned(buffers.size()), &_ring, 0);
+            if(ret < 0) throw systemError(-ret, "io_uring_queue_init failed");
+
+            // Fixed buffers save the kernel from mapping each buffer per write,
+            // but are limited by RLIMIT_MEMLOCK, so they're optional.
+            std::vector<iovec> iovecs;
+            for(auto* buffer: buffers) iovecs.emplace_back(iovec{buffer, bufferSize});
+            _fixedBuffers = (0 == io_uring_register_buffers(&_ring, iovecs.data(), unsigned(iovecs.size())));
+        }
+
+        ~IOUringBackend() override
+        {
+            if(_fixedBuffers) io_uring_unregister_buffers(&_ring);
+            io_uring_queue_exit(&_ring);
+        }
+
+        const char* name() const override
+        {
+            return "io_uring";
+        }
+
+        void submit(
+            const size_t index,
+            const uint8_t* data,
+            const size_t size,
+            const uint64_t offset) override
+        {
+            auto& request = _requests[index];
+            request = Request{index, data, size, offset};
+            _queue(request);
+        }
+
+        Completion waitForCompletion() override
+        {
+            while(true)
+            {
+                io_uring_cqe* cqe = nullptr;
+                const int ret = io_uring_wait_cqe(&_ring, &cqe);
+                if(ret == -EINTR) continue;
+                else if(ret < 0) throw systemError(-ret, "io_uring_wait_cqe failed");
+
+                auto* request = static_cast<Request*>(io_uring_cqe_get_data(cqe));
+                const int res = cqe->res;
+                io_uring_cqe_seen(&_ring, cqe);
+
+                if(res < 0) return Completion{request->index, -res};
+                else if(res == 0) return Completion{request->index, EIO};
+
+                // Resubmit the remainder of short writes.
+                if(size_t(res) < request->size)
+                {
+                    request->data += res;
+                    request->size -= size_t(res);
+                    request->offset += uint64_t(res);
+                    _queue(*request);
+                    continue;
+                }
+
+                return Completion{request->index, 0};
+            }
+        }
+
+    private:
+        struct Request
+        {
+            size_t index;
+            const uint8_t* data;
+            size_t size;
+            uint64_t offset;
+        };
+
+        void _queue(Request& request)
+        {
+            io_uring_sqe* sqe = io_uring_get_sqe(&_ring);
+            if(!sqe) throw std::runtime_error("RecordingSink: io_uring submission queue full");
+
+            if(_fixedBuffers)
+            {
+                io_uring_prep_write_fixed(
+                    sqe,
+                    _fd,
+                    request.data,
+                    unsigned(request.size),
+                    request.offset,
+                    int(request.index));
+            }
+            else
+            {
+                io_uring_prep_write(
+                    sqe,
+                    _fd,
+                    request.data,
+                    unsigned(request.size),
+                    request.offset);
+            }
+            io_uring_sqe_set_data(sqe, &request);
+
+            const int ret = io_uring_submit(&_ring);
+            if(ret < 0) throw systemError(-ret, "io_uring_submit failed");
+        }
+
+        int _fd;
+        io_uring _ring;
+        bool _fixedBuffers{false};
+        std::vector<Request> _requests;
+    };
+#endif
+
+    //
+    // Implementation
+    //
+
+    class RecordingSink::Impl
+    {
+    public:
+        Impl(
+            const std::string& path,
+            const std::string& sourceFormat,
+            const std::string& targetFormat,
+            const double scalar,
+            const Args& args):
+            _converter(SoapySDR::ConverterRegistry::getFunction(sourceFormat, targetFormat, args.priority)),
+            _scalar(scalar),
+            _sourceSize(SoapySDR::formatToSize(sourceFormat)),
+            _targetSize(SoapySDR::formatToSize(targetFormat))
+        {
+            if(args.numBuffers == 0) throw std::invalid_argument("RecordingSink: numBuffers must be nonzero");
+
+            // Every format size divides the alignment, so a full buffer
+            // always ends on an element boundary.
+            _bufferSize = roundUp(std::max<size_t>(args.bufferElems, 1) * _targetSize, DirectIOAlignment);
+
+            _openFile(path, args.directIO);
+
+            try
+            {
+                for(size_t i = 0; i < args.numBuffers; ++i)
+                {
+                    auto* buffer = static_cast<uint8_t*>(volk_malloc(_bufferSize, DirectIOAlignment));
+                    if(!buffer) throw std::bad_alloc();
+
+                    _buffers.emplace_back(buffer);
+                    _freeBuffers.push_back(i);
+                }
+
+                _createBackend(args);
+            }
+            catch(...)
+            {
+                _releaseResources();
+                throw;
+            }
+        }
+
+        ~Impl()
+        {
+            _releaseResources();
+        }
+
+        void write(const void* srcBuff, const size_t numElems)
+        {
+            if(_fd < 0) throw std::runtime_error("RecordingSink: sink is closed");
+
+            auto* src = static_cast<const uint8_t*>(srcBuff);
+            size_t remaining = numElems;
+            while(remaining > 0)
+            {
+                if(_current == NoBuffer) _current = _acquireBuffer();
+
+                const size_t count = std::min(remaining, (_bufferSize - _currentFill) / _targetSize);
+                _converter(
+                    src,
+                    _buffers[_current] + _currentFill,
+                    count,
+                    _scalar);
+
+                src += (count * _sourceSize);
+                remaining -= count;
+                _currentFill += (count * _targetSize);
+
+                if(_currentFill == _bufferSize)
+                {
+                    _submit(_current, _bufferSize);
+
+                    _currentOffset += _bufferSize;
+                    _current = NoBuffer;
+                    _currentFill = 0;
+                }
+            }
+        }
+
+        void flush()
+        {
+            if(_fd < 0) return;
+
+            // The partial buffer stays current after it's written, so later
+            // samples are appended to it and it's rewritten in place. This
+            // keeps every write offset aligned for O_DIRECT.
+            if((_current != NoBuffer) && (_currentFill > 0))
+            {
+                const size_t size = _directIO ? roundUp(_currentFill, DirectIOAlignment) : _currentFill;
+                std::memset(_buffers[_current] + _currentFill, 0, size - _currentFill);
+
+                _submit(_current, size);
+            }
+
+            while(_numInFlight > 0) _reapOne();
+        }
+
+        void close()
+        {
+            if(_fd < 0) return;
+
+            flush();
+
+            const uint64_t length = bytesWritten();
+            if(0 != ::ftruncate(_fd, off_t(length))) throw systemError(errno, "ftruncate failed");
+
+            _releaseResources();
+        }
+
+        std::string backend() const
+        {
+            return _backend ? _backend->name() : "";
+        }
+
+        bool isDirectIO() const
+        {
+            return _directIO;
+        }
+
+        uint64_t bytesWritten() const
+        {
+            return _currentOffset + _currentFill;
+        }
+
+    private:
+        static constexpr size_t NoBuffer = size_t(-1);
+
+        void _openFile(const std::string& path, const bool directIO)
+        {
+            constexpr int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+
+#ifdef O_DIRECT
+            if(directIO)
+            {
+                // Filesystems like tmpfs reject O_DIRECT, so fall back to
+                // buffered I/O.
+                _fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+                _directIO = (_fd >= 0);
+            }
+#else
+            (void)directIO;
+#endif
+            if(_fd < 0) _fd = ::open(path.c_str(), flags, 0644);
+            if(_fd < 0) throw systemError(errno, "failed to open " + path);
+        }
+
+        void _createBackend(const Args& args)
+        {
+#ifdef HAVE_LIBURING
+            if(args.backend != Backend::ThreadPool)
+            {
+                try
+                {
+                    _backend.reset(new IOUringBackend(_fd, _buffers, _bufferSize));
+                    return;
+                }
+                catch(const std::exception& ex)
+                {
+                    // io_uring is often disabled in containers or by seccomp.
+                    if(args.backend == Backend::IOUring) throw;
+                    SoapySDR::logf(
+                        SOAPY_SDR_DEBUG,
+                        "RecordingSink: io_uring unavailable (%s), using pwrite",
+                        ex.what());
+                }
+            }
+#else
+            if(args.backend == Backend::IOUring)
+            {
+                throw std::runtime_error("RecordingSink: built without io_uring support");
+            }
+#endif
+            _backend.reset(new ThreadPoolBackend(_fd, args.numThreads));
+        }
+
+        size_t _acquireBuffer()
+        {
+            while(_freeBuffers.empty()) _reapOne();
+
+            const size_t index = _freeBuffers.front();
+            _freeBuffers.pop_front();
+
+            return index;
+        }
+
+        void _submit(const size_t index, const size_t size)
+        {
+            _backend->submit(index, _buffers[index], size, _currentOffset);
+            ++_numInFlight;
+        }
+
+        // The buffer is reclaimed before a failed write throws, so flush()
+        // and close() don't wait for it again.
+        void _reapOne()
+        {
+            const auto completion = _backend->waitForCompletion();
+            --_numInFlight;
+
+            if(completion.index != _current) _freeBuffers.push_back(completion.index);
+            if(completion.error != 0) throw systemError(completion.error, std::string(_backend->name()) + " write failed");
+        }
+
+        void _releaseResources()
+        {
+            // In-flight writes still reference the buffers, so wait for them
+            // before freeing anything. Errors were already reported.
+            while(_backend && (_numInFlight > 0))
+            {
+                --_numInFlight;
+                try
+                {
+                    _backend->waitForCompletion();
+                }
+                catch(...)
+                {
+                }
+            }
+            _backend.reset();
+
+            for(auto* buffer: _buffers) volk_free(buffer);
+            _buffers.clear();
+            _freeBuffers.clear();
+
+            if(_fd >= 0) ::close(_fd);
+            _fd = -1;
+        }
+
+        SoapySDR::ConverterRegistry::ConverterFunction _converter;
+        double _scalar;
+        size_t _sourceSize;
+        size_t _targetSize;
+
+        int _fd{-1};
+        bool _directIO{false};
+
+        size_t _bufferSize{0};
+        std::vector<uint8_t*> _buffers;
+        std::deque<size_t> _freeBuffers;
+        size_t _numInFlight{0};
+
+        size_t _current{NoBuffer};
+        size_t _currentFill{0};
+        uint64_t _currentOffset{0};
+
+        std::unique_ptr<IOBackend> _backend;
+    };
+
+    //
+    // RecordingSink
+    //
+
+    RecordingSink::RecordingSink(
+        const std::string& path,
+        const std::string& sourceFormat,
+        const std::string& targetFormat,
+        const double scalar):
+        RecordingSink(path, sourceFormat, targetFormat, scalar, Args())
+    {
+    }
+
+    RecordingSink::RecordingSink(
+        const std::string& path,
+        const std::string& sourceFormat,
+        const std::string& targetFormat,
+        const double scalar,
+        const Args& args):
+        _impl(new Impl(path, sourceFormat, targetFormat, scalar, args))
+    {
+    }
+
+    RecordingSink::~RecordingSink()
+    {
+        try
+        {
+            _impl->close();
+        }
+        catch(const std::exception& ex)
+        {
+            SoapySDR::logf(SOAPY_SDR_ERROR, "RecordingSink: error closing file: %s", ex.what());
+        }
+    }
+
+    void RecordingSink::write(const void* srcBuff, const size_t numElems)
+    {
+        _impl->write(srcBuff, numElems);
+    }
+
+    void RecordingSink::flush()
+    {
+        _impl->flush();
+    }
+
+    void RecordingSink::close()
+    {
+        _impl->close();
+    }
+
+    std::string RecordingSink::backend() const
+    {
+        return _impl->backend();
+    }
+
+    bool RecordingSink::isDirectIO() const
+    {
+        return _impl->isDirectIO();
+    }
+
+    uint64_t RecordingSink::bytesWritten() const
+    {
+        return _impl->bytesWritten();
+    }
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <SoapySDR/ConverterRegistry.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace SoapyVOLKConverters
+{
+    //
+    // Converts samples into a pool of aligned buffers and writes completed
+    // buffers to disk asynchronously, so conversion and disk I/O overlap.
+    //
+    // Buffers are written with O_DIRECT where the filesystem supports it.
+    // I/O is submitted through io_uring when available, falling back to a
+    // thread pool calling pwrite().
+    //
+    // The converter is looked up through SoapySDR's ConverterRegistry, so
+    // the VOLK module must be loaded before a sink is created.
+    //
+    class RecordingSink
+    {
+    public:
+        enum class Backend
+        {
+            Auto,
+            IOUring,
+            ThreadPool
+        };
+
+        struct Args
+        {
+            // Size of each buffer in target-format elements, rounded up to
+            // the direct I/O alignment.
+            size_t bufferElems{1 << 18};
+
+            // Number of buffers in the pool, i.e. the maximum number of
+            // buffers being converted into or written at once.
+            size_t numBuffers{8};
+
+            // Workers used by the thread pool backend.
+            size_t numThreads{2};
+
+            Backend backend{Backend::Auto};
+
+            bool directIO{true};
+
+            SoapySDR::ConverterRegistry::FunctionPriority priority{SoapySDR::ConverterRegistry::VECTORIZED};
+        };
+
+        RecordingSink(
+            const std::string& path,
+            const std::string& sourceFormat,
+            const std::string& targetFormat,
+            const double scalar);
+
+        RecordingSink(
+            const std::string& path,
+            const std::string& sourceFormat,
+            const std::string& targetFormat,
+            const double scalar,
+            const Args& args);
+
+        // Flushes any remaining samples, waits for outstanding writes, and
+        // closes the file. Errors are logged rather than thrown.
+        ~RecordingSink();
+
+        RecordingSink(const RecordingSink&) = delete;
+        RecordingSink& operator=(const RecordingSink&) = delete;
+
+        // Converts numElems source-format elements into the pool, submitting
+        // each buffer as it fills. Blocks only when every buffer is in flight.
+        void write(const void* srcBuff, const size_t numElems);
+
+        // Submits the partially filled buffer and waits for all writes.
+        void flush();
+
+        // Flushes, truncates the file to the number of bytes written, and
+        // closes it. Further calls to write() throw.
+        void close();
+
+        // Returns "io_uring" or "pwrite".
+        std::string backend() const;
+
+        bool isDirectIO() const;
+
+        uint64_t bytesWritten() const;
+
+        class Impl;
+
+    private:
+        std::unique_ptr<Impl> _impl;
+    };
+}
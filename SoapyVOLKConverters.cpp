@@ -5,6 +5,11 @@
  * A Soapy module that adds type converters implemented in VOLK
  **********************************************************************/
 
+#include "Instrumentation.hpp"
+#include "Metrics.hpp"
+#include "SoapyVOLKConverters.hpp"
+#include "Tracing.hpp"
+
 #include <SoapySDR/ConverterRegistry.hpp>
 #include <SoapySDR/Logger.hpp>
 
@@ -12,6 +17,16 @@
 #include <volk/volk_alloc.hh>
 #include <volk/volk_prefs.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
 //
 // Initialization
 //
@@ -30,140 +45,330 @@ struct ModuleInit
                 SOAPY_SDR_WARNING,
                 "SoapyVOLKConverters: no VOLK config file found. Run volk_profile for best performance.");
         }
+
+        SoapyVOLKConverters::initStats();
+        SoapyVOLKConverters::initTrace();
+        SoapyVOLKConverters::initMetrics();
     }
 };
 
 static const ModuleInit Init;
 
+//
+// Zero-skip
+//
+
+static constexpr size_t CacheLineSize = 64;
+
+static std::atomic<uint64_t> ZeroSkipBlockCount(0);
+
+// OR-reduces a cache line at a time, stopping at the first line with a
+// nonzero sample, so dense signals only pay for one line per block. Sign
+// bits are masked out, since -0.0 converts to 0 as well.
+static bool isZeroBlock(const float* samples, const size_t numSamples)
+{
+    constexpr size_t SamplesPerLine = CacheLineSize / sizeof(float);
+    constexpr uint64_t NonSignMask = 0x7FFFFFFF7FFFFFFFULL;
+
+    const auto* bytes = reinterpret_cast<const uint8_t*>(samples);
+
+    size_t i = 0;
+    for(; (i + SamplesPerLine) <= numSamples; i += SamplesPerLine)
+    {
+        uint64_t accum = 0;
+        for(size_t j = 0; j < CacheLineSize; j += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + (i * sizeof(float)) + j, sizeof(word));
+            accum |= word;
+        }
+
+        if(accum & NonSignMask) return false;
+    }
+    for(; i < numSamples; ++i)
+    {
+        if(samples[i] != 0.0f) return false;
+    }
+
+    return true;
+}
+
+// Converts runs of nonzero blocks with a single kernel call each and fills
+// all-zero blocks directly. Blocks are a multiple of the SIMD width, so
+// splitting the buffer doesn't change which VOLK implementation is used.
+template <typename OutType, typename ConvertFcn>
+static void convertWithZeroSkip(
+    const float* src,
+    OutType* dst,
+    const size_t numElems,
+    ConvertFcn convert)
+{
+    constexpr size_t BlockElems = SoapyVOLKConverters::ZeroSkipBlockSize / sizeof(float);
+
+    size_t runStart = 0;
+    uint64_t numSkipped = 0;
+
+    for(size_t blockStart = 0; blockStart < numElems; blockStart += BlockElems)
+    {
+        const size_t blockElems = std::min(BlockElems, (numElems - blockStart));
+        if(!isZeroBlock(src + blockStart, blockElems)) continue;
+
+        if(blockStart > runStart)
+        {
+            convert(dst + runStart, src + runStart, (blockStart - runStart));
+        }
+        std::memset(dst + blockStart, 0, (blockElems * sizeof(OutType)));
+
+        runStart = blockStart + blockElems;
+        ++numSkipped;
+    }
+    if(numElems > runStart)
+    {
+        convert(dst + runStart, src + runStart, (numElems - runStart));
+    }
+
+    if(numSkipped > 0)
+    {
+        ZeroSkipBlockCount.fetch_add(numSkipped, std::memory_order_relaxed);
+        SoapyVOLKConverters::countZeroSkipCall();
+    }
+}
+
+uint64_t SoapyVOLKConverters_getZeroSkipBlockCount(void)
+{
+    return ZeroSkipBlockCount.load(std::memory_order_relaxed);
+}
+
+void SoapyVOLKConverters_resetZeroSkipBlockCount(void)
+{
+    ZeroSkipBlockCount.store(0, std::memory_order_relaxed);
+}
+
 //
 // Common code
 //
 
+// Allocates a two-stage converter's intermediate buffer, counted in its
+// statistics.
+static volk::vector<float> allocateScratch(const size_t numElems)
+{
+    SoapyVOLKConverters::countScratchAllocation(numElems * sizeof(float));
+    return volk::vector<float>(numElems);
+}
+
 static void convertS8ToF64(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
 {
-    volk::vector<float> intermediate(numElems);
+    SoapyVOLKConverters::StageTimer timer;
+    auto intermediate = allocateScratch(numElems);
+    timer.endStage(SoapyVOLKConverters::AllocStage);
+
     volk_8i_s32f_convert_32f(
         intermediate.data(),
         reinterpret_cast<const int8_t*>(srcBuff),
         static_cast<float>(1.0 / scalar),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::FirstStage);
 
     volk_32f_convert_64f(
         reinterpret_cast<double*>(dstBuff),
         intermediate.data(),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::SecondStage);
 }
 
 static void convertS16ToF64(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
 {
-    volk::vector<float> intermediate(numElems);
+    SoapyVOLKConverters::StageTimer timer;
+    auto intermediate = allocateScratch(numElems);
+    timer.endStage(SoapyVOLKConverters::AllocStage);
+
     volk_16i_s32f_convert_32f(
         intermediate.data(),
         reinterpret_cast<const int16_t*>(srcBuff),
         static_cast<float>(1.0 / scalar),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::FirstStage);
 
     volk_32f_convert_64f(
         reinterpret_cast<double*>(dstBuff),
         intermediate.data(),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::SecondStage);
 }
 
 static void convertS32ToF64(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
 {
-    volk::vector<float> intermediate(numElems);
+    SoapyVOLKConverters::StageTimer timer;
+    auto intermediate = allocateScratch(numElems);
+    timer.endStage(SoapyVOLKConverters::AllocStage);
+
     volk_32i_s32f_convert_32f(
         intermediate.data(),
         reinterpret_cast<const int32_t*>(srcBuff),
         static_cast<float>(1.0 / scalar),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::FirstStage);
 
     volk_32f_convert_64f(
         reinterpret_cast<double*>(dstBuff),
         intermediate.data(),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::SecondStage);
 }
 
 static void convertF32ToF64(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
 {
-    volk::vector<float> scaled(numElems);
+    SoapyVOLKConverters::StageTimer timer;
+    auto scaled = allocateScratch(numElems);
+    timer.endStage(SoapyVOLKConverters::AllocStage);
+
     volk_32f_s32f_multiply_32f(
         scaled.data(),
         (const float*)srcBuff,
         static_cast<float>(scalar),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::FirstStage);
 
     volk_32f_convert_64f(
         (double*)dstBuff,
         scaled.data(),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::SecondStage);
+}
+
+static void convertF32ToS8(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
+{
+    convertWithZeroSkip(
+        reinterpret_cast<const float*>(srcBuff),
+        reinterpret_cast<int8_t*>(dstBuff),
+        numElems,
+        [scalar](int8_t* dst, const float* src, const size_t num)
+        {
+            volk_32f_s32f_convert_8i(
+                dst,
+                src,
+                static_cast<float>(scalar),
+                static_cast<unsigned int>(num));
+        });
+}
+
+static void convertF32ToS16(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
+{
+    convertWithZeroSkip(
+        reinterpret_cast<const float*>(srcBuff),
+        reinterpret_cast<int16_t*>(dstBuff),
+        numElems,
+        [scalar](int16_t* dst, const float* src, const size_t num)
+        {
+            volk_32f_s32f_convert_16i(
+                dst,
+                src,
+                static_cast<float>(scalar),
+                static_cast<unsigned int>(num));
+        });
+}
+
+static void convertF32ToS32(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
+{
+    convertWithZeroSkip(
+        reinterpret_cast<const float*>(srcBuff),
+        reinterpret_cast<int32_t*>(dstBuff),
+        numElems,
+        [scalar](int32_t* dst, const float* src, const size_t num)
+        {
+            volk_32f_s32f_convert_32i(
+                dst,
+                src,
+                static_cast<float>(scalar),
+                static_cast<unsigned int>(num));
+        });
 }
 
 static void convertF64ToS8(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
 {
-    volk::vector<float> intermediate(numElems);
+    SoapyVOLKConverters::StageTimer timer;
+    auto intermediate = allocateScratch(numElems);
+    timer.endStage(SoapyVOLKConverters::AllocStage);
+
     volk_64f_convert_32f(
         intermediate.data(),
         reinterpret_cast<const double*>(srcBuff),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::FirstStage);
 
     volk_32f_s32f_convert_8i(
         reinterpret_cast<int8_t*>(dstBuff),
         intermediate.data(),
         static_cast<float>(scalar),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::SecondStage);
 }
 
 static void convertF64ToS16(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
 {
-    volk::vector<float> intermediate(numElems);
+    SoapyVOLKConverters::StageTimer timer;
+    auto intermediate = allocateScratch(numElems);
+    timer.endStage(SoapyVOLKConverters::AllocStage);
+
     volk_64f_convert_32f(
         intermediate.data(),
         reinterpret_cast<const double*>(srcBuff),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::FirstStage);
 
     volk_32f_s32f_convert_16i(
         reinterpret_cast<int16_t*>(dstBuff),
         intermediate.data(),
         static_cast<float>(scalar),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::SecondStage);
 }
 
 static void convertF64ToS32(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
 {
-    volk::vector<float> intermediate(numElems);
+    SoapyVOLKConverters::StageTimer timer;
+    auto intermediate = allocateScratch(numElems);
+    timer.endStage(SoapyVOLKConverters::AllocStage);
+
     volk_64f_convert_32f(
         intermediate.data(),
         reinterpret_cast<const double*>(srcBuff),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::FirstStage);
 
     volk_32f_s32f_convert_32i(
         reinterpret_cast<int32_t*>(dstBuff),
         intermediate.data(),
         static_cast<float>(scalar),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::SecondStage);
 }
 
 static void convertF64ToF32(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
 {
-    volk::vector<float> unscaled(numElems);
+    SoapyVOLKConverters::StageTimer timer;
+    auto unscaled = allocateScratch(numElems);
+    timer.endStage(SoapyVOLKConverters::AllocStage);
+
     volk_64f_convert_32f(
         unscaled.data(),
         (const double*)srcBuff,
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::FirstStage);
 
     volk_32f_s32f_multiply_32f(
         (float*)dstBuff,
         unscaled.data(),
         static_cast<float>(scalar),
         static_cast<unsigned int>(numElems));
+    timer.endStage(SoapyVOLKConverters::SecondStage);
 }
 
 //
 // int8_t
 //
 
-static SoapySDR::ConverterRegistry registerS8ToS16(
+static SoapyVOLKConverters::ConverterRegistration registerS8ToS16(
     SOAPY_SDR_S8,
     SOAPY_SDR_S16,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -173,9 +378,10 @@ static SoapySDR::ConverterRegistry registerS8ToS16(
             reinterpret_cast<int16_t*>(dstBuff),
             reinterpret_cast<const int8_t*>(srcBuff),
             static_cast<unsigned int>(numElems));
-    });
+    },
+    "volk_8i_convert_16i");
 
-static SoapySDR::ConverterRegistry registerS8ToF32(
+static SoapyVOLKConverters::ConverterRegistration registerS8ToF32(
     SOAPY_SDR_S8,
     SOAPY_SDR_F32,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -186,19 +392,21 @@ static SoapySDR::ConverterRegistry registerS8ToF32(
             reinterpret_cast<const int8_t*>(srcBuff),
             static_cast<float>(1.0 / scalar),
             static_cast<unsigned int>(numElems));
-    });
+    },
+    "volk_8i_s32f_convert_32f");
 
-static SoapySDR::ConverterRegistry registerS8ToF64(
+static SoapyVOLKConverters::ConverterRegistration registerS8ToF64(
     SOAPY_SDR_S8,
     SOAPY_SDR_F64,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    &convertS8ToF64);
+    &convertS8ToF64,
+    "volk_8i_s32f_convert_32f,volk_32f_convert_64f");
 
 //
 // int16_t
 //
 
-static SoapySDR::ConverterRegistry registerS16ToS8(
+static SoapyVOLKConverters::ConverterRegistration registerS16ToS8(
     SOAPY_SDR_S16,
     SOAPY_SDR_S8,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -208,9 +416,10 @@ static SoapySDR::ConverterRegistry registerS16ToS8(
             reinterpret_cast<int8_t*>(dstBuff),
             reinterpret_cast<const int16_t*>(srcBuff),
             static_cast<unsigned int>(numElems));
-    });
+    },
+    "volk_16i_convert_8i");
 
-static SoapySDR::ConverterRegistry registerS16ToF32(
+static SoapyVOLKConverters::ConverterRegistration registerS16ToF32(
     SOAPY_SDR_S16,
     SOAPY_SDR_F32,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -221,19 +430,21 @@ static SoapySDR::ConverterRegistry registerS16ToF32(
             reinterpret_cast<const int16_t*>(srcBuff),
             static_cast<float>(1.0 / scalar),
             static_cast<unsigned int>(numElems));
-    });
+    },
+    "volk_16i_s32f_convert_32f");
 
-static SoapySDR::ConverterRegistry registerS16ToF64(
+static SoapyVOLKConverters::ConverterRegistration registerS16ToF64(
     SOAPY_SDR_S16,
     SOAPY_SDR_F64,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    &convertS16ToF64);
+    &convertS16ToF64,
+    "volk_16i_s32f_convert_32f,volk_32f_convert_64f");
 
 //
 // int32_t
 //
 
-static SoapySDR::ConverterRegistry registerS32ToF32(
+static SoapyVOLKConverters::ConverterRegistration registerS32ToF32(
     SOAPY_SDR_S32,
     SOAPY_SDR_F32,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -244,58 +455,42 @@ static SoapySDR::ConverterRegistry registerS32ToF32(
             reinterpret_cast<const int32_t*>(srcBuff),
             static_cast<float>(1.0 / scalar),
             static_cast<unsigned int>(numElems));
-    });
+    },
+    "volk_32i_s32f_convert_32f");
 
-static SoapySDR::ConverterRegistry registerS32ToF64(
+static SoapyVOLKConverters::ConverterRegistration registerS32ToF64(
     SOAPY_SDR_S32,
     SOAPY_SDR_F64,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    &convertS32ToF64);
+    &convertS32ToF64,
+    "volk_32i_s32f_convert_32f,volk_32f_convert_64f");
 
 //
 // float
 //
 
-static SoapySDR::ConverterRegistry registerF32ToS8(
+static SoapyVOLKConverters::ConverterRegistration registerF32ToS8(
     SOAPY_SDR_F32,
     SOAPY_SDR_S8,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
-    {
-        volk_32f_s32f_convert_8i(
-            reinterpret_cast<int8_t*>(dstBuff),
-            reinterpret_cast<const float*>(srcBuff),
-            static_cast<float>(scalar),
-            static_cast<unsigned int>(numElems));
-    });
+    &convertF32ToS8,
+    "volk_32f_s32f_convert_8i");
 
-static SoapySDR::ConverterRegistry registerF32ToS16(
+static SoapyVOLKConverters::ConverterRegistration registerF32ToS16(
     SOAPY_SDR_F32,
     SOAPY_SDR_S16,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
-    {
-        volk_32f_s32f_convert_16i(
-            reinterpret_cast<int16_t*>(dstBuff),
-            reinterpret_cast<const float*>(srcBuff),
-            static_cast<float>(scalar),
-            static_cast<unsigned int>(numElems));
-    });
+    &convertF32ToS16,
+    "volk_32f_s32f_convert_16i");
 
-static SoapySDR::ConverterRegistry registerF32ToS32(
+static SoapyVOLKConverters::ConverterRegistration registerF32ToS32(
     SOAPY_SDR_F32,
     SOAPY_SDR_S32,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
-    {
-        volk_32f_s32f_convert_32i(
-            reinterpret_cast<int32_t*>(dstBuff),
-            reinterpret_cast<const float*>(srcBuff),
-            static_cast<float>(scalar),
-            static_cast<unsigned int>(numElems));
-    });
+    &convertF32ToS32,
+    "volk_32f_s32f_convert_32i");
 
-static SoapySDR::ConverterRegistry registerF32ToF32(
+static SoapyVOLKConverters::ConverterRegistration registerF32ToF32(
     SOAPY_SDR_F32,
     SOAPY_SDR_F32,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -306,47 +501,53 @@ static SoapySDR::ConverterRegistry registerF32ToF32(
             reinterpret_cast<const float*>(srcBuff),
             static_cast<float>(scalar),
             static_cast<unsigned int>(numElems));
-    });
+    },
+    "volk_32f_s32f_multiply_32f");
 
-static SoapySDR::ConverterRegistry registerF32ToF64(
+static SoapyVOLKConverters::ConverterRegistration registerF32ToF64(
     SOAPY_SDR_F32,
     SOAPY_SDR_F64,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    &convertF32ToF64);
+    &convertF32ToF64,
+    "volk_32f_s32f_multiply_32f,volk_32f_convert_64f");
 
 //
 // double
 //
 
-static SoapySDR::ConverterRegistry registerF64ToS8(
+static SoapyVOLKConverters::ConverterRegistration registerF64ToS8(
     SOAPY_SDR_F64,
     SOAPY_SDR_S8,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    &convertF64ToS8);
+    &convertF64ToS8,
+    "volk_64f_convert_32f,volk_32f_s32f_convert_8i");
 
-static SoapySDR::ConverterRegistry registerF64ToS16(
+static SoapyVOLKConverters::ConverterRegistration registerF64ToS16(
     SOAPY_SDR_F64,
     SOAPY_SDR_S16,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    &convertF64ToS16);
+    &convertF64ToS16,
+    "volk_64f_convert_32f,volk_32f_s32f_convert_16i");
 
-static SoapySDR::ConverterRegistry registerF64ToS32(
+static SoapyVOLKConverters::ConverterRegistration registerF64ToS32(
     SOAPY_SDR_F64,
     SOAPY_SDR_S32,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    &convertF64ToS32);
+    &convertF64ToS32,
+    "volk_64f_convert_32f,volk_32f_s32f_convert_32i");
 
-static SoapySDR::ConverterRegistry registerF64ToF32(
+static SoapyVOLKConverters::ConverterRegistration registerF64ToF32(
     SOAPY_SDR_F64,
     SOAPY_SDR_F32,
     SoapySDR::ConverterRegistry::VECTORIZED,
-    &convertF64ToF32);
+    &convertF64ToF32,
+    "volk_64f_convert_32f,volk_32f_s32f_multiply_32f");
 
 //
 // std::complex<int8_t>
 //
 
-static SoapySDR::ConverterRegistry registerCS8ToCS16(
+static SoapyVOLKConverters::ConverterRegistration registerCS8ToCS16(
     SOAPY_SDR_CS8,
     SOAPY_SDR_CS16,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -356,9 +557,10 @@ static SoapySDR::ConverterRegistry registerCS8ToCS16(
             reinterpret_cast<int16_t*>(dstBuff),
             reinterpret_cast<const int8_t*>(srcBuff),
             static_cast<unsigned int>(numElems * 2));
-    });
+    },
+    "volk_8i_convert_16i");
 
-static SoapySDR::ConverterRegistry registerCS8ToCF32(
+static SoapyVOLKConverters::ConverterRegistration registerCS8ToCF32(
     SOAPY_SDR_CS8,
     SOAPY_SDR_CF32,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -369,22 +571,24 @@ static SoapySDR::ConverterRegistry registerCS8ToCF32(
             reinterpret_cast<const int8_t*>(srcBuff),
             static_cast<float>(1.0 / scalar),
             static_cast<unsigned int>(numElems * 2));
-    });
+    },
+    "volk_8i_s32f_convert_32f");
 
-static SoapySDR::ConverterRegistry registerCS8ToCF64(
+static SoapyVOLKConverters::ConverterRegistration registerCS8ToCF64(
     SOAPY_SDR_CS8,
     SOAPY_SDR_CF64,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
         convertS8ToF64(srcBuff, dstBuff, (numElems * 2), scalar);
-    });
+    },
+    "volk_8i_s32f_convert_32f,volk_32f_convert_64f");
 
 //
 // std::complex<int16_t>
 //
 
-static SoapySDR::ConverterRegistry registerCS16ToCS8(
+static SoapyVOLKConverters::ConverterRegistration registerCS16ToCS8(
     SOAPY_SDR_CS16,
     SOAPY_SDR_CS8,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -394,9 +598,10 @@ static SoapySDR::ConverterRegistry registerCS16ToCS8(
             reinterpret_cast<int8_t*>(dstBuff),
             reinterpret_cast<const int16_t*>(srcBuff),
             static_cast<unsigned int>(numElems * 2));
-    });
+    },
+    "volk_16i_convert_8i");
 
-static SoapySDR::ConverterRegistry registerCS16ToCF32(
+static SoapyVOLKConverters::ConverterRegistration registerCS16ToCF32(
     SOAPY_SDR_CS16,
     SOAPY_SDR_CF32,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -407,22 +612,24 @@ static SoapySDR::ConverterRegistry registerCS16ToCF32(
             reinterpret_cast<const int16_t*>(srcBuff),
             static_cast<float>(1.0 / scalar),
             static_cast<unsigned int>(numElems * 2));
-    });
+    },
+    "volk_16i_s32f_convert_32f");
 
-static SoapySDR::ConverterRegistry registerCS16ToCF64(
+static SoapyVOLKConverters::ConverterRegistration registerCS16ToCF64(
     SOAPY_SDR_CS16,
     SOAPY_SDR_CF64,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
         convertS16ToF64(srcBuff, dstBuff, (numElems * 2), scalar);
-    });
+    },
+    "volk_16i_s32f_convert_32f,volk_32f_convert_64f");
 
 //
 // std::complex<int32_t>
 //
 
-static SoapySDR::ConverterRegistry registerCS32ToCF32(
+static SoapyVOLKConverters::ConverterRegistration registerCS32ToCF32(
     SOAPY_SDR_CS32,
     SOAPY_SDR_CF32,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -433,61 +640,54 @@ static SoapySDR::ConverterRegistry registerCS32ToCF32(
             reinterpret_cast<const int32_t*>(srcBuff),
             static_cast<float>(1.0 / scalar),
             static_cast<unsigned int>(numElems * 2));
-    });
+    },
+    "volk_32i_s32f_convert_32f");
 
-static SoapySDR::ConverterRegistry registerCS32ToCF64(
+static SoapyVOLKConverters::ConverterRegistration registerCS32ToCF64(
     SOAPY_SDR_CS32,
     SOAPY_SDR_CF64,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
         convertS32ToF64(srcBuff, dstBuff, (numElems * 2), scalar);
-    });
+    },
+    "volk_32i_s32f_convert_32f,volk_32f_convert_64f");
 
 //
 // std::complex<float>
 //
 
-static SoapySDR::ConverterRegistry registerCF32ToCS8(
+static SoapyVOLKConverters::ConverterRegistration registerCF32ToCS8(
     SOAPY_SDR_CF32,
     SOAPY_SDR_CS8,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
-        volk_32f_s32f_convert_8i(
-            reinterpret_cast<int8_t*>(dstBuff),
-            reinterpret_cast<const float*>(srcBuff),
-            static_cast<float>(scalar),
-            static_cast<unsigned int>(numElems * 2));
-    });
+        convertF32ToS8(srcBuff, dstBuff, (numElems * 2), scalar);
+    },
+    "volk_32f_s32f_convert_8i");
 
-static SoapySDR::ConverterRegistry registerCF32ToCS16(
+static SoapyVOLKConverters::ConverterRegistration registerCF32ToCS16(
     SOAPY_SDR_CF32,
     SOAPY_SDR_CS16,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
-        volk_32f_s32f_convert_16i(
-            reinterpret_cast<int16_t*>(dstBuff),
-            reinterpret_cast<const float*>(srcBuff),
-            static_cast<float>(scalar),
-            static_cast<unsigned int>(numElems * 2));
-    });
+        convertF32ToS16(srcBuff, dstBuff, (numElems * 2), scalar);
+    },
+    "volk_32f_s32f_convert_16i");
 
-static SoapySDR::ConverterRegistry registerCF32ToCS32(
+static SoapyVOLKConverters::ConverterRegistration registerCF32ToCS32(
     SOAPY_SDR_CF32,
     SOAPY_SDR_CS32,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
-        volk_32f_s32f_convert_32i(
-            reinterpret_cast<int32_t*>(dstBuff),
-            reinterpret_cast<const float*>(srcBuff),
-            static_cast<float>(scalar),
-            static_cast<unsigned int>(numElems * 2));
-    });
+        convertF32ToS32(srcBuff, dstBuff, (numElems * 2), scalar);
+    },
+    "volk_32f_s32f_convert_32i");
 
-static SoapySDR::ConverterRegistry registerCF32ToCF32(
+static SoapyVOLKConverters::ConverterRegistration registerCF32ToCF32(
     SOAPY_SDR_CF32,
     SOAPY_SDR_CF32,
     SoapySDR::ConverterRegistry::VECTORIZED,
@@ -498,53 +698,228 @@ static SoapySDR::ConverterRegistry registerCF32ToCF32(
             reinterpret_cast<const float*>(srcBuff),
             static_cast<float>(scalar),
             static_cast<unsigned int>(numElems * 2));
-    });
+    },
+    "volk_32f_s32f_multiply_32f");
 
-static SoapySDR::ConverterRegistry registerCF32ToCF64(
+static SoapyVOLKConverters::ConverterRegistration registerCF32ToCF64(
     SOAPY_SDR_CF32,
     SOAPY_SDR_CF64,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
         convertF32ToF64(srcBuff, dstBuff, (numElems * 2), scalar);
-    });
+    },
+    "volk_32f_s32f_multiply_32f,volk_32f_convert_64f");
 
 //
 // std::complex<double>
 //
 
-static SoapySDR::ConverterRegistry registerCF64ToCS8(
+static SoapyVOLKConverters::ConverterRegistration registerCF64ToCS8(
     SOAPY_SDR_CF64,
     SOAPY_SDR_CS8,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
         convertF64ToS8(srcBuff, dstBuff, (numElems * 2), scalar);
-    });
+    },
+    "volk_64f_convert_32f,volk_32f_s32f_convert_8i");
 
-static SoapySDR::ConverterRegistry registerCF64ToCS16(
+static SoapyVOLKConverters::ConverterRegistration registerCF64ToCS16(
     SOAPY_SDR_CF64,
     SOAPY_SDR_CS16,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
         convertF64ToS16(srcBuff, dstBuff, (numElems * 2), scalar);
-    });
+    },
+    "volk_64f_convert_32f,volk_32f_s32f_convert_16i");
 
-static SoapySDR::ConverterRegistry registerCF64ToCS32(
+static SoapyVOLKConverters::ConverterRegistration registerCF64ToCS32(
     SOAPY_SDR_CF64,
     SOAPY_SDR_CS32,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
         convertF64ToS32(srcBuff, dstBuff, (numElems * 2), scalar);
-    });
+    },
+    "volk_64f_convert_32f,volk_32f_s32f_convert_32i");
 
-static SoapySDR::ConverterRegistry registerCF64ToF32(
+static SoapyVOLKConverters::ConverterRegistration registerCF64ToF32(
     SOAPY_SDR_CF64,
     SOAPY_SDR_CF32,
     SoapySDR::ConverterRegistry::VECTORIZED,
     [](const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
     {
         convertF64ToF32(srcBuff, dstBuff, (numElems * 2), scalar);
-    });
+    },
+    "volk_64f_convert_32f,volk_32f_s32f_multiply_32f");
+
+//
+// Fast tier
+//
+
+// The largest float that converts to OutType without overflowing. For 32-bit
+// integers, float(INT32_MAX) rounds up to 2^31, which is out of range.
+template <typename OutType>
+static constexpr float truncateMax()
+{
+    return (sizeof(OutType) < sizeof(int32_t)) ? float(std::numeric_limits<OutType>::max())
+                                                : 2147483520.0f;
+}
+
+// Scales in float and truncates, which the compiler vectorizes without the
+// rounding-mode handling round-to-nearest needs. Comparisons are ordered so
+// NaN clamps to the minimum, as converting NaN to an integer is undefined.
+template <typename InType, typename OutType>
+static void convertToIntTruncate(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
+{
+    constexpr float minVal = float(std::numeric_limits<OutType>::min());
+    constexpr float maxVal = truncateMax<OutType>();
+
+    const auto* src = reinterpret_cast<const InType*>(srcBuff);
+    auto* dst = reinterpret_cast<OutType*>(dstBuff);
+    const float floatScalar = static_cast<float>(scalar);
+
+    for(size_t i = 0; i < numElems; ++i)
+    {
+        float val = static_cast<float>(src[i]) * floatScalar;
+        val = (val >= minVal) ? val : minVal;
+        val = (val <= maxVal) ? val : maxVal;
+        dst[i] = static_cast<OutType>(val);
+    }
+}
+
+// Skips the float intermediate and its allocation.
+template <typename InType>
+static void convertToF64Direct(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
+{
+    const auto* src = reinterpret_cast<const InType*>(srcBuff);
+    auto* dst = reinterpret_cast<double*>(dstBuff);
+
+    for(size_t i = 0; i < numElems; ++i) dst[i] = static_cast<double>(src[i]) * scalar;
+}
+
+template <typename InType, typename OutType>
+static void convertComplexToIntTruncate(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
+{
+    convertToIntTruncate<InType, OutType>(srcBuff, dstBuff, (numElems * 2), scalar);
+}
+
+template <typename InType>
+static void convertComplexToF64Direct(const void* srcBuff, void* dstBuff, const size_t numElems, const double scalar)
+{
+    convertToF64Direct<InType>(srcBuff, dstBuff, (numElems * 2), scalar);
+}
+
+struct FastConverter
+{
+    const char* source;
+    const char* target;
+    SoapySDR::ConverterRegistry::ConverterFunction function;
+};
+
+static const FastConverter FastConverters[] =
+{
+    {SOAPY_SDR_F32, SOAPY_SDR_S8, &convertToIntTruncate<float, int8_t>},
+    {SOAPY_SDR_F32, SOAPY_SDR_S16, &convertToIntTruncate<float, int16_t>},
+    {SOAPY_SDR_F32, SOAPY_SDR_S32, &convertToIntTruncate<float, int32_t>},
+    {SOAPY_SDR_F64, SOAPY_SDR_S8, &convertToIntTruncate<double, int8_t>},
+    {SOAPY_SDR_F64, SOAPY_SDR_S16, &convertToIntTruncate<double, int16_t>},
+    {SOAPY_SDR_F64, SOAPY_SDR_S32, &convertToIntTruncate<double, int32_t>},
+    {SOAPY_SDR_S8, SOAPY_SDR_F64, &convertToF64Direct<int8_t>},
+    {SOAPY_SDR_S16, SOAPY_SDR_F64, &convertToF64Direct<int16_t>},
+    {SOAPY_SDR_S32, SOAPY_SDR_F64, &convertToF64Direct<int32_t>},
+
+    {SOAPY_SDR_CF32, SOAPY_SDR_CS8, &convertComplexToIntTruncate<float, int8_t>},
+    {SOAPY_SDR_CF32, SOAPY_SDR_CS16, &convertComplexToIntTruncate<float, int16_t>},
+    {SOAPY_SDR_CF32, SOAPY_SDR_CS32, &convertComplexToIntTruncate<float, int32_t>},
+    {SOAPY_SDR_CF64, SOAPY_SDR_CS8, &convertComplexToIntTruncate<double, int8_t>},
+    {SOAPY_SDR_CF64, SOAPY_SDR_CS16, &convertComplexToIntTruncate<double, int16_t>},
+    {SOAPY_SDR_CF64, SOAPY_SDR_CS32, &convertComplexToIntTruncate<double, int32_t>},
+    {SOAPY_SDR_CS8, SOAPY_SDR_CF64, &convertComplexToF64Direct<int8_t>},
+    {SOAPY_SDR_CS16, SOAPY_SDR_CF64, &convertComplexToF64Direct<int16_t>},
+    {SOAPY_SDR_CS32, SOAPY_SDR_CF64, &convertComplexToF64Direct<int32_t>},
+};
+
+// Registers every fast variant at FastPriority, and the pairs listed in
+// SOAPY_VOLK_FAST_CONVERTERS at FastDefaultPriority as well.
+class FastTierRegistry
+{
+public:
+    FastTierRegistry()
+    {
+        const auto defaultPairs = getDefaultPairs();
+        const bool allPairs = (std::find(defaultPairs.begin(), defaultPairs.end(), "all") != defaultPairs.end());
+
+        for(const auto& converter: FastConverters)
+        {
+            _registrations.emplace_back(new SoapyVOLKConverters::ConverterRegistration(
+                converter.source,
+                converter.target,
+                SoapyVOLKConverters::FastPriority,
+                converter.function));
+
+            const std::string pair = std::string(converter.source) + ":" + converter.target;
+            if(allPairs || (std::find(defaultPairs.begin(), defaultPairs.end(), pair) != defaultPairs.end()))
+            {
+                _registrations.emplace_back(new SoapyVOLKConverters::ConverterRegistration(
+                    converter.source,
+                    converter.target,
+                    SoapyVOLKConverters::FastDefaultPriority,
+                    converter.function));
+
+                SoapySDR::logf(
+                    SOAPY_SDR_INFO,
+                    "SoapyVOLKConverters: %s -> %s defaults to the fast converter",
+                    converter.source,
+                    converter.target);
+            }
+        }
+
+        for(const auto& pair: defaultPairs)
+        {
+            if((pair != "all") && !isFastPair(pair))
+            {
+                SoapySDR::logf(
+                    SOAPY_SDR_WARNING,
+                    "SoapyVOLKConverters: no fast converter for \"%s\" in SOAPY_VOLK_FAST_CONVERTERS",
+                    pair.c_str());
+            }
+        }
+    }
+
+private:
+    static std::vector<std::string> getDefaultPairs()
+    {
+        std::vector<std::string> pairs;
+
+        const char* env = std::getenv("SOAPY_VOLK_FAST_CONVERTERS");
+        if(env)
+        {
+            std::stringstream stream(env);
+            std::string pair;
+            while(std::getline(stream, pair, ','))
+            {
+                if(!pair.empty()) pairs.emplace_back(pair);
+            }
+        }
+
+        return pairs;
+    }
+
+    static bool isFastPair(const std::string& pair)
+    {
+        return std::any_of(
+            std::begin(FastConverters),
+            std::end(FastConverters),
+            [&pair](const FastConverter& converter)
+            {
+                return (pair == (std::string(converter.source) + ":" + converter.target));
+            });
+    }
+
+    std::vector<std::unique_ptr<SoapyVOLKConverters::ConverterRegistration>> _registrations;
+};
+
+static const FastTierRegistry FastTier;
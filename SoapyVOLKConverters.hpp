@@ -0,0 +1,262 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+//
+// Functions exported by the module beyond what SoapySDR's converter registry
+// exposes. They have C linkage so applications that load the module through
+// SoapySDR can look them up by name (dlsym() or GetProcAddress()).
+//
+
+#include <SoapySDR/Config.h>
+#include <SoapySDR/ConverterRegistry.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef volkConverters_EXPORTS
+#define SOAPY_VOLK_CONVERTERS_API extern "C" SOAPY_SDR_HELPER_DLL_EXPORT
+#else
+#define SOAPY_VOLK_CONVERTERS_API extern "C" SOAPY_SDR_HELPER_DLL_IMPORT
+#endif
+
+//
+// Zero-skip
+//
+
+namespace SoapyVOLKConverters
+{
+    // TX converters check their input in blocks of this many bytes, and fill
+    // the output for any block of all zeros rather than converting it.
+    constexpr size_t ZeroSkipBlockSize = 4096;
+}
+
+// Number of input blocks TX (float to integer) converters filled with zeros
+// instead of converting, since the module was loaded or last reset.
+SOAPY_VOLK_CONVERTERS_API uint64_t SoapyVOLKConverters_getZeroSkipBlockCount(void);
+
+SOAPY_VOLK_CONVERTERS_API void SoapyVOLKConverters_resetZeroSkipBlockCount(void);
+
+//
+// Accuracy tiers
+//
+
+namespace SoapyVOLKConverters
+{
+    // Every converter is registered at VECTORIZED priority with the module's
+    // exact behavior. Some pairs also have a fast variant, registered at
+    // FastPriority, that trades accuracy for speed:
+    //
+    //  * (C)F32/(C)F64 -> (C)S8/(C)S16/(C)S32: rounds toward zero instead of
+    //    to nearest, and (C)F64 is converted in a single pass without scratch
+    //    memory. Within 1 LSB of the exact converter for inputs within full
+    //    scale. Inputs beyond it, including infinities, saturate: S8 and S16
+    //    to the integer limits, like the exact converter, and S32 to the
+    //    minimum or 2147483520 (2^31 - 128, the largest float below 2^31),
+    //    where the exact converter's result depends on VOLK's implementation.
+    //    NaN of either sign becomes the minimum integer.
+    //  * (C)S8/(C)S16/(C)S32 -> (C)F64: a single pass in double precision,
+    //    skipping the float intermediate. Within a relative 2^-23 of the exact
+    //    converter.
+    //
+    // Get a fast variant with SoapySDR::ConverterRegistry::getFunction(source,
+    // target, FastPriority). To make it the default for a pair, list the pair
+    // in the SOAPY_VOLK_FAST_CONVERTERS environment variable (for example
+    // "CF32:CS16,F64:S16", or "all") before loading the module. The module
+    // then also registers it at FastDefaultPriority, above the exact variant.
+    constexpr SoapySDR::ConverterRegistry::FunctionPriority FastPriority =
+        SoapySDR::ConverterRegistry::FunctionPriority(SoapySDR::ConverterRegistry::VECTORIZED - 1);
+
+    constexpr SoapySDR::ConverterRegistry::FunctionPriority FastDefaultPriority =
+        SoapySDR::ConverterRegistry::FunctionPriority(SoapySDR::ConverterRegistry::VECTORIZED + 1);
+}
+
+//
+// Converter statistics
+//
+
+namespace SoapyVOLKConverters
+{
+    // Calls with fewer elements than this are counted as small-buffer calls,
+    // where per-call overhead outweighs the vectorized kernels.
+    constexpr size_t SmallBufferElems = 256;
+}
+
+// Totals for one registered converter. Each thread counts its own calls, and
+// the counts are summed when read, so recording never contends.
+struct SoapyVOLKConvertersStats
+{
+    const char* sourceFormat;
+    const char* targetFormat;
+    int priority;
+
+    uint64_t calls;
+    uint64_t elements;
+    uint64_t bytes; // Read and written
+    uint64_t nanoseconds;
+
+    // Calls that took slower paths
+    uint64_t unalignedCalls;   // A buffer not aligned for VOLK's aligned kernels
+    uint64_t smallBufferCalls; // Fewer than SmallBufferElems elements
+
+    // Calls that filled at least one all-zero input block instead of
+    // converting it. A fast path, counted per converter, where
+    // SoapyVOLKConverters_getZeroSkipBlockCount() counts blocks.
+    uint64_t zeroSkipCalls;
+
+    // Float to integer outputs at the integer limits. Only counted while
+    // enabled with SoapyVOLKConverters_setSaturationCountingEnabled(), as it
+    // takes a scalar pass over the output, which can add tens of percent to a
+    // call.
+    uint64_t saturatedSamples;
+
+    // Time in each stage of the two-stage F64 converters, which allocate an
+    // intermediate float buffer, then call one kernel into it and another out
+    // of it. Allocation includes freeing the buffer. Only timed while enabled
+    // with SoapyVOLKConverters_setStageTimingEnabled(), for stageTimedCalls
+    // calls.
+    uint64_t stageTimedCalls;
+    uint64_t allocNanoseconds;
+    uint64_t firstStageNanoseconds;
+    uint64_t secondStageNanoseconds;
+
+    // Scratch memory allocated by the converter, such as the F64 converters'
+    // intermediate buffers, and the largest single allocation.
+    uint64_t allocations;
+    uint64_t allocatedBytes;
+    uint64_t peakScratchBytes;
+};
+
+// Fills up to maxStats entries, one per converter the module registered, and
+// returns the number of registered converters.
+SOAPY_VOLK_CONVERTERS_API size_t SoapyVOLKConverters_getStats(SoapyVOLKConvertersStats* stats, size_t maxStats);
+
+SOAPY_VOLK_CONVERTERS_API void SoapyVOLKConverters_resetStats(void);
+
+// Statistics are recorded by default. Set SOAPY_VOLK_STATS=0 before loading
+// the module to start with them disabled.
+SOAPY_VOLK_CONVERTERS_API void SoapyVOLKConverters_setStatsEnabled(bool enabled);
+
+SOAPY_VOLK_CONVERTERS_API bool SoapyVOLKConverters_getStatsEnabled(void);
+
+// Logs statistics for every converter that was called when the module is
+// unloaded. Also enabled by setting SOAPY_VOLK_STATS_LOG=1.
+SOAPY_VOLK_CONVERTERS_API void SoapyVOLKConverters_setLogStatsOnUnload(bool enabled);
+
+SOAPY_VOLK_CONVERTERS_API void SoapyVOLKConverters_setSaturationCountingEnabled(bool enabled);
+
+SOAPY_VOLK_CONVERTERS_API bool SoapyVOLKConverters_getSaturationCountingEnabled(void);
+
+// Also enabled by setting SOAPY_VOLK_STAGE_TIMING=1. Stages are only timed
+// while statistics are enabled.
+SOAPY_VOLK_CONVERTERS_API void SoapyVOLKConverters_setStageTimingEnabled(bool enabled);
+
+//
+// Latency histograms
+//
+
+namespace SoapyVOLKConverters
+{
+    // Pass as the size class to SoapyVOLKConverters_getLatencyQuantileNs() to
+    // combine every buffer size.
+    constexpr size_t AllSizeClasses = size_t(-1);
+}
+
+// Each converter's call latencies are recorded in log-linear buckets (eight
+// per power of two, so within 12.5%), per class of buffer size. Latencies are
+// timed with the CPU's cycle counter where available and reported in
+// nanoseconds. Converters are indexed as in SoapyVOLKConverters_getStats(), and
+// histograms are reset along with it.
+SOAPY_VOLK_CONVERTERS_API size_t SoapyVOLKConverters_getNumSizeClasses(void);
+
+// The smallest number of elements in each size class. Classes span a factor
+// of four, starting at 256 elements, up to 1M+ elements.
+SOAPY_VOLK_CONVERTERS_API size_t SoapyVOLKConverters_getSizeClassMinElems(size_t sizeClass);
+
+SOAPY_VOLK_CONVERTERS_API size_t SoapyVOLKConverters_getNumLatencyBuckets(void);
+
+SOAPY_VOLK_CONVERTERS_API double SoapyVOLKConverters_getLatencyBucketMinNs(size_t bucket);
+
+// Fills counts, which must have SoapyVOLKConverters_getNumLatencyBuckets()
+// entries. Returns false if the converter or size class is out of range.
+SOAPY_VOLK_CONVERTERS_API bool SoapyVOLKConverters_getLatencyHistogram(size_t converter, size_t sizeClass, uint64_t* counts);
+
+// Returns the upper bound of the bucket containing the given quantile (0-1),
+// or NaN if the converter has no calls in the size class.
+SOAPY_VOLK_CONVERTERS_API double SoapyVOLKConverters_getLatencyQuantileNs(size_t converter, size_t sizeClass, double quantile);
+
+// Writes every nonzero bucket as CSV, and returns 0 or an errno value. Also
+// written when the module is unloaded if SOAPY_VOLK_LATENCY_CSV is set to a
+// path.
+SOAPY_VOLK_CONVERTERS_API int SoapyVOLKConverters_exportLatencyHistograms(const char* path);
+
+//
+// Tracing
+//
+
+// Set SOAPY_VOLK_TRACE to a path before loading the module to record a
+// begin/end event pair, with the format pair, element count, and thread, for
+// every converter call. Events are buffered per thread without locking, and
+// written as Chrome trace JSON (viewable in Perfetto or chrome://tracing) when
+// the module is unloaded. Without the variable, tracing costs one branch per
+// call.
+SOAPY_VOLK_CONVERTERS_API bool SoapyVOLKConverters_getTraceEnabled(void);
+
+// Writes the events recorded so far, and returns 0 or an errno value.
+SOAPY_VOLK_CONVERTERS_API int SoapyVOLKConverters_writeTrace(const char* path);
+
+//
+// Metrics
+//
+
+// Set SOAPY_VOLK_METRICS before loading the module to publish statistics in
+// the Prometheus text format, from a low-priority background thread, every
+// SOAPY_VOLK_METRICS_INTERVAL_MS milliseconds (default 5000). Set it to a file
+// path to rewrite that file, or to "unix:" followed by a path to serve the
+// latest metrics to each connection on a UNIX socket. Saturated samples are
+// only published while saturation counting is enabled, which
+// SOAPY_VOLK_METRICS_SATURATION=1 does at load. Not supported on Windows.
+//
+// Copies the current metrics into text, truncated to maxLength including the
+// null terminator, and returns the full length.
+SOAPY_VOLK_CONVERTERS_API size_t SoapyVOLKConverters_getMetricsText(char* text, size_t maxLength);
+
+//
+// Introspection
+//
+
+// One VOLK kernel a registered converter calls, and the implementations VOLK
+// dispatches it to on this machine for aligned and unaligned buffers.
+// selectedBy is "default" (VOLK's ranking by available architectures),
+// "config" (the config file written by volk_profile), or "VOLK_GENERIC" (set in
+// the environment). Converters that don't call VOLK, such as the fast tier,
+// have a single entry with empty kernel fields.
+struct SoapyVOLKConvertersKernelInfo
+{
+    const char* sourceFormat;
+    const char* targetFormat;
+    int priority;
+
+    const char* kernel;
+    const char* alignedImpl;
+    const char* unalignedImpl;
+    const char* selectedBy;
+};
+
+// Fills up to maxInfo entries, one per converter and kernel, in the same
+// converter order as SoapyVOLKConverters_getStats(), and returns the number
+// of entries.
+SOAPY_VOLK_CONVERTERS_API size_t SoapyVOLKConverters_getKernelInfo(SoapyVOLKConvertersKernelInfo* info, size_t maxInfo);
+
+// The VOLK config file consulted, or an empty string if there isn't one
+SOAPY_VOLK_CONVERTERS_API const char* SoapyVOLKConverters_getVOLKConfigPath(void);
+
+// The function this module registered for a conversion, or null if it has
+// none. SoapySDR keeps the first registration of each conversion, so this is
+// how to call a second copy of the module, such as another build loaded to
+// compare against.
+SOAPY_VOLK_CONVERTERS_API SoapySDR::ConverterRegistry::ConverterFunction SoapyVOLKConverters_getConverter(
+    const char* sourceFormat,
+    const char* targetFormat,
+    int priority);
@@ -0,0 +1,106 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+//
+// Lists every converter the module registers, the VOLK kernels behind each,
+// and the implementations VOLK dispatches them to on this machine.
+//
+// Usage: SoapyVOLKConvertersInfo [module path]
+//
+// Without a path, the module is found among SoapySDR's installed modules.
+//
+
+#include "ModuleLoader.hpp"
+#include "SoapyVOLKConverters.hpp"
+
+#include <SoapySDR/ConverterRegistry.hpp>
+#include <SoapySDR/Modules.hpp>
+
+#include <volk/volk.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::string findInstalledModule()
+{
+    for (const auto& path: SoapySDR::listModules())
+    {
+        if (path.find("volkConverters") != std::string::npos) return path;
+    }
+
+    return "";
+}
+
+static std::string getPriorityName(int priority)
+{
+    if (priority == SoapyVOLKConverters::FastDefaultPriority) return "fast, default via SOAPY_VOLK_FAST_CONVERTERS";
+    if (priority == SoapyVOLKConverters::FastPriority) return "fast";
+    if (priority == SoapySDR::ConverterRegistry::VECTORIZED) return "vectorized";
+
+    return std::to_string(priority);
+}
+
+static std::string getEnv(const char* name)
+{
+    const char* value = std::getenv(name);
+    return value ? value : "(unset)";
+}
+
+int main(int argc, char** argv)
+{
+    const std::string modulePath = (argc > 1) ? argv[1] : findInstalledModule();
+    if (modulePath.empty())
+    {
+        std::cerr << "SoapyVOLKConverters module not found. Pass its path as an argument." << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!ModuleLoader::loadSoapyVOLK(modulePath)) return EXIT_FAILURE;
+
+    try
+    {
+        auto getKernelInfo = GET_MODULE_FUNCTION(SoapyVOLKConverters_getKernelInfo);
+        auto getVOLKConfigPath = GET_MODULE_FUNCTION(SoapyVOLKConverters_getVOLKConfigPath);
+
+        const std::string configPath = getVOLKConfigPath();
+
+        std::cout << std::endl;
+        std::cout << "VOLK version:               " << volk_version() << std::endl;
+        std::cout << "VOLK machine:               " << volk_get_machine() << std::endl;
+        std::cout << "VOLK config:                " << (configPath.empty() ? "(none, run volk_profile)" : configPath) << std::endl;
+        std::cout << "VOLK_GENERIC:               " << getEnv("VOLK_GENERIC") << std::endl;
+        std::cout << "SOAPY_VOLK_FAST_CONVERTERS: " << getEnv("SOAPY_VOLK_FAST_CONVERTERS") << std::endl;
+
+        std::vector<SoapyVOLKConvertersKernelInfo> allInfo(getKernelInfo(nullptr, 0));
+        getKernelInfo(allInfo.data(), allInfo.size());
+
+        std::string lastConverter;
+        for (const auto& info: allInfo)
+        {
+            const std::string converter = std::string(info.sourceFormat) + " -> " + info.targetFormat + " (" + getPriorityName(info.priority) + ")";
+            if (converter != lastConverter)
+            {
+                std::cout << std::endl << converter << std::endl;
+                lastConverter = converter;
+            }
+
+            if (info.kernel[0] == '\0')
+            {
+                std::cout << "    no VOLK kernels" << std::endl;
+                continue;
+            }
+
+            std::cout << "    " << info.kernel << ": aligned " << info.alignedImpl
+                      << ", unaligned " << info.unalignedImpl
+                      << " (" << info.selectedBy << ")" << std::endl;
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
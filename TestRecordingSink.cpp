@@ -0,0 +1,176 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#include "RecordingSink.hpp"
+#include "TestUtility.hpp"
+
+#include <SoapySDR/ConverterRegistry.hpp>
+#include <SoapySDR/Formats.hpp>
+
+#include <volk/volk_alloc.hh>
+
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using RecordingSink = SoapyVOLKConverters::RecordingSink;
+
+// Deliberately not a multiple of the buffer or chunk size, so the final
+// buffer is partial.
+static constexpr size_t numElements = 100003;
+static constexpr size_t chunkSize = 3001;
+
+static std::vector<char> readFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static bool testRecordingSink(
+    const std::string& name,
+    RecordingSink::Backend backend,
+    bool flushMidStream)
+{
+    std::cout << "Testing " << SOAPY_SDR_CF32 << " -> " << SOAPY_SDR_CS16 << " recording (" << name << ")..." << std::endl;
+
+    const std::string path = "TestRecordingSink.bin";
+    const auto input = TestUtility::getRandomValues<std::complex<float>>(numElements);
+
+    volk::vector<std::complex<int16_t>> expected(numElements);
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS16,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+    converter(input.data(), expected.data(), numElements, TestUtility::F32ToS16Scalar);
+
+    try
+    {
+        RecordingSink::Args args;
+        args.bufferElems = 4096;
+        args.numBuffers = 4;
+        args.backend = backend;
+
+        RecordingSink sink(path, SOAPY_SDR_CF32, SOAPY_SDR_CS16, TestUtility::F32ToS16Scalar, args);
+        std::cout << " * Backend: " << sink.backend() << (sink.isDirectIO() ? " (O_DIRECT)" : "") << std::endl;
+
+        for(size_t i = 0; i < numElements; i += chunkSize)
+        {
+            sink.write(input.data() + i, std::min(chunkSize, numElements - i));
+            if(flushMidStream && (i == (chunkSize * 5))) sink.flush();
+        }
+
+        sink.close();
+        if(sink.bytesWritten() != (numElements * sizeof(expected[0])))
+        {
+            std::cerr << " * Wrote " << sink.bytesWritten() << " bytes, expected " << (numElements * sizeof(expected[0])) << std::endl;
+            return false;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << " * Exception: " << ex.what() << std::endl;
+        return false;
+    }
+
+    const auto written = readFile(path);
+    std::remove(path.c_str());
+
+    if(written.size() != (numElements * sizeof(expected[0])))
+    {
+        std::cerr << " * File is " << written.size() << " bytes, expected " << (numElements * sizeof(expected[0])) << std::endl;
+        return false;
+    }
+    if(0 != std::memcmp(written.data(), expected.data(), written.size()))
+    {
+        std::cerr << " * File contents don't match converted samples" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Writes to a device that fails every write with ENOSPC, and checks the
+// error is thrown and the sink still destructs instead of waiting on the
+// failed write.
+static bool testWriteError(
+    const std::string& name,
+    RecordingSink::Backend backend)
+{
+    std::cout << "Testing write errors (" << name << ")..." << std::endl;
+
+    const std::string path = "/dev/full";
+    if(!std::ifstream(path))
+    {
+        std::cout << " * " << path << " unavailable, skipping" << std::endl;
+        return true;
+    }
+
+    const auto input = TestUtility::getRandomValues<std::complex<float>>(numElements);
+
+    bool threw = false;
+    try
+    {
+        RecordingSink::Args args;
+        args.bufferElems = 4096;
+        args.numBuffers = 4;
+        args.backend = backend;
+
+        RecordingSink sink(path, SOAPY_SDR_CF32, SOAPY_SDR_CS16, TestUtility::F32ToS16Scalar, args);
+        try
+        {
+            for(size_t i = 0; i < numElements; i += chunkSize)
+            {
+                sink.write(input.data() + i, std::min(chunkSize, numElements - i));
+            }
+            sink.flush();
+        }
+        catch(const std::system_error& ex)
+        {
+            std::cout << " * Threw: " << ex.what() << std::endl;
+            threw = true;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << " * Exception: " << ex.what() << std::endl;
+        return false;
+    }
+
+    if(!threw)
+    {
+        std::cerr << " * Writing to " << path << " didn't throw" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+//
+// Main
+//
+
+int main(int, char**)
+{
+    if (!ModuleLoader::loadSoapyVOLK()) return EXIT_FAILURE;
+
+    bool success = true;
+
+    success &= testRecordingSink("auto", RecordingSink::Backend::Auto, false);
+    success &= testRecordingSink("thread pool", RecordingSink::Backend::ThreadPool, false);
+    success &= testRecordingSink("auto, flushed mid-stream", RecordingSink::Backend::Auto, true);
+    success &= testRecordingSink("thread pool, flushed mid-stream", RecordingSink::Backend::ThreadPool, true);
+    success &= testWriteError("auto", RecordingSink::Backend::Auto);
+    success &= testWriteError("thread pool", RecordingSink::Backend::ThreadPool);
+
+    std::cout << "-----" << std::endl;
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
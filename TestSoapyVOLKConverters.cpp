@@ -1,18 +1,33 @@
 // Copyright (c) 2019-2021 Nicholas Corgan
 // SPDX-License-Identifier: GPL-3.0
 
+#include "SoapyVOLKConverters.hpp"
 #include "TestUtility.hpp"
 
 #include <SoapySDR/ConverterRegistry.hpp>
 #include <SoapySDR/Formats.hpp>
 
+#include <volk/volk.h>
 #include <volk/volk_alloc.hh>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 struct TestConverters
 {
@@ -47,7 +62,7 @@ bool getConvertFunctions(
 }
 
 template <typename T>
-TestUtility::EnableIfNotComplex<T, void> testOutputs(
+TestUtility::EnableIfNotComplex<T, double> testOutputs(
     const volk::vector<T>& vec0,
     const volk::vector<T>& vec1)
 {
@@ -60,10 +75,12 @@ TestUtility::EnableIfNotComplex<T, void> testOutputs(
         medAbsDev);
 
     std::cout << " * Average diff: " << double(median) << " +- " << double(medAbsDev) << std::endl;
+
+    return double(median);
 }
 
 template <typename T>
-TestUtility::EnableIfComplex<T, void> testOutputs(
+TestUtility::EnableIfComplex<T, double> testOutputs(
     const volk::vector<T>& vec0,
     const volk::vector<T>& vec1)
 {
@@ -78,13 +95,50 @@ TestUtility::EnableIfComplex<T, void> testOutputs(
         medAbsDev);
 
     std::cout << " * Average complex diff: " << double(median) << " +- " << double(medAbsDev) << std::endl;
+
+    return double(median);
+}
+
+// Full scale, and one step of a format at unit full scale. Converters compute
+// in single precision, so no step is finer than a float's near full scale.
+static double getFullScale(std::string format)
+{
+    if (format[0] == 'C') format = format.substr(1);
+    if (format == SOAPY_SDR_S8) return double(TestUtility::S8FullScale);
+    if (format == SOAPY_SDR_S16) return double(TestUtility::S16FullScale);
+    if (format == SOAPY_SDR_S32) return double(TestUtility::S32FullScale);
+
+    return 1.0;
+}
+
+static double getStep(const std::string& format)
+{
+    static constexpr double FloatStep = double(std::numeric_limits<float>::epsilon()) / 2.0;
+    const bool isFloat = (format.find('F') != std::string::npos);
+
+    return isFloat ? FloatStep : std::max(1.0 / getFullScale(format), FloatStep);
+}
+
+// The most the median loopback diff can be, in type1's units. Each sample
+// can be off by up to a step of the coarser format, and saturated samples
+// by more, but they're never the majority. sparse_zeros is mostly exact
+// zeros, which must come back exact.
+static double getLoopbackTolerance(
+    const std::string& type1,
+    const std::string& type2,
+    const TestUtility::Signal signal)
+{
+    if (signal == TestUtility::Signal::SparseZeros) return 0.0;
+
+    return getFullScale(type1) * std::max(getStep(type1), getStep(type2));
 }
 
 template <typename InType, typename OutType>
 bool testConverterLoopback(
     const std::string& type1,
     const std::string& type2,
-    const double type1ToType2Scalar)
+    const double type1ToType2Scalar,
+    const TestUtility::Signal signal)
 {
     static constexpr size_t numElements = 1024*8;
 
@@ -99,7 +153,7 @@ bool testConverterLoopback(
     if (!testConverters.convertType1ToType2) return false;
     if (!testConverters.convertType2ToType1) return false;
 
-    const volk::vector<InType> testValues = TestUtility::getRandomValues<InType>(numElements);
+    const volk::vector<InType> testValues = TestUtility::getSignalValues<InType>(signal, numElements);
     volk::vector<OutType> convertedValues(numElements);
     volk::vector<InType> loopbackValues(numElements);
 
@@ -114,7 +168,936 @@ bool testConverterLoopback(
         numElements,
         (1.0 / type1ToType2Scalar));
 
-    testOutputs(testValues, loopbackValues);
+    const double maxDiff = getLoopbackTolerance(type1, type2, signal);
+    if (testOutputs(testValues, loopbackValues) > maxDiff)
+    {
+        std::cerr << " * Expected an average diff of at most " << maxDiff << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Compares a TX converter against calling its VOLK kernel directly on a
+// buffer with zero stretches, including a block of -0.0, and checks that the
+// all-zero blocks were counted.
+template <typename OutType, typename KernelFcn>
+bool testZeroSkip(
+    const std::string& source,
+    const std::string& target,
+    const double scalar,
+    KernelFcn volkKernel)
+{
+    static constexpr size_t numScalars = 1024*16;
+    static constexpr size_t blockScalars = SoapyVOLKConverters::ZeroSkipBlockSize / sizeof(float);
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing zero-skip for " << source << " -> " << target << "..." << std::endl;
+
+    const size_t numScalarsPerElem = (source[0] == 'C') ? 2 : 1;
+    const size_t numElems = numScalars / numScalarsPerElem;
+
+    // Bursts that start and end mid-block, so only some blocks are skippable
+    auto input = TestUtility::getSparseBurstValues<float>(numScalars, 700, 3000);
+    for (size_t i = 0; i < blockScalars; ++i) input[(numScalars - blockScalars) + i] = -0.0f;
+
+    size_t expectedSkipped = 0;
+    for (size_t i = 0; i < numScalars; i += blockScalars)
+    {
+        const bool isZero = std::all_of(
+            input.begin() + i,
+            input.begin() + i + blockScalars,
+            [](float val) { return val == 0.0f; });
+        if (isZero) ++expectedSkipped;
+    }
+
+    volk::vector<OutType> expected(numScalars);
+    volk::vector<OutType> output(numScalars);
+    volkKernel(expected.data(), input.data(), static_cast<float>(scalar), static_cast<unsigned int>(numScalars));
+
+    auto resetCount = GET_MODULE_FUNCTION(SoapyVOLKConverters_resetZeroSkipBlockCount);
+    auto getCount = GET_MODULE_FUNCTION(SoapyVOLKConverters_getZeroSkipBlockCount);
+
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        source,
+        target,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+
+    resetCount();
+    converter(input.data(), output.data(), numElems, scalar);
+    const uint64_t numSkipped = getCount();
+
+    std::cout << " * Skipped " << numSkipped << "/" << (numScalars / blockScalars) << " blocks" << std::endl;
+
+    if (0 != std::memcmp(expected.data(), output.data(), (numScalars * sizeof(OutType))))
+    {
+        std::cerr << " * Output doesn't match VOLK kernel" << std::endl;
+        return false;
+    }
+    if (numSkipped != expectedSkipped)
+    {
+        std::cerr << " * Expected " << expectedSkipped << " skipped blocks" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Checks each test signal has the feature it's meant to exercise.
+static bool testSignalFeatures()
+{
+    static constexpr size_t numElements = 1024*16;
+    static constexpr double snrDB = 10.0;
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing signals..." << std::endl;
+
+    bool success = true;
+    auto check = [&success](const bool passed, const std::string& what)
+    {
+        if (!passed)
+        {
+            std::cerr << " * " << what << std::endl;
+            success = false;
+        }
+    };
+
+    const auto tone = TestUtility::getSignalValues<float>(TestUtility::Signal::Tone, numElements);
+    const float tonePeak = *std::max_element(tone.begin(), tone.end());
+    check(std::abs(tonePeak - 0.7f) < 0.01f, "Tone peak is " + std::to_string(tonePeak));
+
+    // The tone's power is 0.25.
+    const auto noisyTone = TestUtility::getSignalValues<std::complex<float>>(TestUtility::Signal::NoisyTone, numElements, snrDB);
+    double power = 0.0;
+    for (const auto& value: noisyTone) power += std::norm(value);
+    const double measuredSNR = 10.0 * std::log10(0.25 / ((power / numElements) - 0.25));
+    std::cout << " * Noisy tone SNR: " << measuredSNR << " dB" << std::endl;
+    check(std::abs(measuredSNR - snrDB) < 1.0, "Noisy tone SNR isn't within 1 dB of " + std::to_string(snrDB));
+
+    const auto clipped = TestUtility::getSignalValues<int16_t>(TestUtility::Signal::ClippedBurst, numElements);
+    check(std::count(clipped.begin(), clipped.end(), std::numeric_limits<int16_t>::max()) > 0, "Clipped burst never reaches +full scale");
+    check(std::count(clipped.begin(), clipped.end(), std::numeric_limits<int16_t>::min()) > 0, "Clipped burst never reaches -full scale");
+
+    const auto sparse = TestUtility::getSignalValues<float>(TestUtility::Signal::SparseZeros, numElements);
+    const auto numZeros = std::count(sparse.begin(), sparse.end(), 0.0f);
+    check((numZeros > 0) && (size_t(numZeros) < numElements), "Sparse zeros has " + std::to_string(numZeros) + " zeros");
+
+    const auto decay = TestUtility::getSignalValues<float>(TestUtility::Signal::DenormalDecay, numElements);
+    const auto numDenormals = std::count_if(decay.begin(), decay.end(), [](float value) { return std::fpclassify(value) == FP_SUBNORMAL; });
+    std::cout << " * Denormal decay: " << numDenormals << "/" << numElements << " denormals" << std::endl;
+    check(numDenormals > 0, "Denormal decay has no denormals");
+
+    const auto edges = TestUtility::getSignalValues<float>(TestUtility::Signal::FullScaleEdges, numElements);
+    check(std::count(edges.begin(), edges.end(), 1.0f) > 0, "Full scale edges has no +full scale");
+    check(std::count_if(edges.begin(), edges.end(), [](float value) { return value < -1.0f; }) > 0, "Full scale edges has nothing beyond -full scale");
+    check(std::count_if(edges.begin(), edges.end(), [](float value) { return (value == 0.0f) && std::signbit(value); }) > 0, "Full scale edges has no -0.0");
+
+    return success;
+}
+
+// Compares a TX converter against calling its VOLK kernel directly on each
+// test signal, so saturation, denormals, and zero-skipping all match. F64
+// inputs are narrowed to float first, as the two-stage converters do.
+template <typename InType, typename OutType, typename KernelFcn>
+bool testSignalConversion(
+    const std::string& source,
+    const std::string& target,
+    const double scalar,
+    KernelFcn volkKernel)
+{
+    static constexpr size_t numScalars = 1024*16;
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing signals for " << source << " -> " << target << "..." << std::endl;
+
+    const size_t numElems = numScalars / ((source[0] == 'C') ? 2 : 1);
+
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        source,
+        target,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+
+    bool success = true;
+    for (const auto signal: TestUtility::getSignals())
+    {
+        const auto input = TestUtility::getSignalValues<InType>(signal, numScalars);
+
+        volk::vector<float> kernelInput(numScalars);
+        std::transform(input.begin(), input.end(), kernelInput.begin(), [](InType value) { return static_cast<float>(value); });
+
+        volk::vector<OutType> expected(numScalars);
+        volk::vector<OutType> output(numScalars);
+        volkKernel(expected.data(), kernelInput.data(), static_cast<float>(scalar), static_cast<unsigned int>(numScalars));
+        converter(input.data(), output.data(), numElems, scalar);
+
+        if (0 != std::memcmp(expected.data(), output.data(), (numScalars * sizeof(OutType))))
+        {
+            std::cerr << " * " << TestUtility::getSignalName(signal) << ": output doesn't match VOLK kernel" << std::endl;
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+// Unlike TestUtility::getRandomValues, covers negative values and, for
+// floating-point types, values beyond full scale to exercise saturation.
+template <typename T>
+static typename std::enable_if<std::is_integral<T>::value, volk::vector<T>>::type getSignedTestValues(
+    size_t numElements,
+    double)
+{
+    std::uniform_int_distribution<int64_t> dist(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+
+    volk::vector<T> values(numElements);
+    for (auto& value: values) value = T(dist(TestUtility::getRandomGenerator()));
+
+    return values;
+}
+
+template <typename T>
+static typename std::enable_if<std::is_floating_point<T>::value, volk::vector<T>>::type getSignedTestValues(
+    size_t numElements,
+    double range)
+{
+    std::uniform_real_distribution<T> dist(T(-range), T(range));
+
+    volk::vector<T> values(numElements);
+    for (auto& value: values) value = dist(TestUtility::getRandomGenerator());
+
+    return values;
+}
+
+// Documented in SoapyVOLKConverters.hpp
+template <typename T>
+static typename std::enable_if<std::is_integral<T>::value, double>::type fastErrorBound(T)
+{
+    return 1.0;
+}
+
+static double fastErrorBound(double exact)
+{
+    return std::ldexp(std::abs(exact), -23);
+}
+
+// Checks a fast-tier converter against the exact converter for the same pair.
+template <typename InType, typename OutType>
+bool testFastConverter(
+    const std::string& source,
+    const std::string& target,
+    const double scalar,
+    const double inputRange)
+{
+    static constexpr size_t numScalars = 1024*8;
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing fast " << source << " -> " << target << " (scaled x" << scalar << ")..." << std::endl;
+
+    const size_t numScalarsPerElem = (source[0] == 'C') ? 2 : 1;
+    const size_t numElems = numScalars / numScalarsPerElem;
+
+    SoapySDR::ConverterRegistry::ConverterFunction exactConverter = nullptr;
+    SoapySDR::ConverterRegistry::ConverterFunction fastConverter = nullptr;
+    try
+    {
+        exactConverter = SoapySDR::ConverterRegistry::getFunction(
+            source,
+            target,
+            SoapySDR::ConverterRegistry::VECTORIZED);
+        fastConverter = SoapySDR::ConverterRegistry::getFunction(
+            source,
+            target,
+            SoapyVOLKConverters::FastPriority);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << " * Exception getting converters: " << ex.what() << std::endl;
+        return false;
+    }
+
+    const auto input = getSignedTestValues<InType>(numScalars, inputRange);
+    volk::vector<OutType> exactOutput(numScalars);
+    volk::vector<OutType> fastOutput(numScalars);
+
+    exactConverter(input.data(), exactOutput.data(), numElems, scalar);
+    fastConverter(input.data(), fastOutput.data(), numElems, scalar);
+
+    double maxError = 0.0;
+    for (size_t i = 0; i < numScalars; ++i)
+    {
+        const double error = std::abs(double(fastOutput[i]) - double(exactOutput[i]));
+        if (error > fastErrorBound(exactOutput[i]))
+        {
+            std::cerr << " * Index " << i << ": fast " << double(fastOutput[i])
+                      << ", exact " << double(exactOutput[i]) << std::endl;
+            return false;
+        }
+        maxError = std::max(maxError, error);
+    }
+
+    std::cout << " * Max error: " << maxError << std::endl;
+
+    return true;
+}
+
+// Checks a fast-tier S32 converter saturates inputs at and beyond full scale
+// as documented, where the exact converter's behavior depends on VOLK.
+template <typename InType>
+bool testFastS32Saturation(
+    const std::string& source,
+    const std::string& target)
+{
+    static constexpr int32_t positiveLimit = 2147483520;
+    static const InType inputs[] = {InType(1.0), InType(1.5), InType(1e10), InType(-1.0), InType(-1.5), InType(-1e10)};
+    static constexpr size_t numScalars = sizeof(inputs) / sizeof(inputs[0]);
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing fast " << source << " -> " << target << " saturation..." << std::endl;
+
+    const size_t numElems = numScalars / ((source[0] == 'C') ? 2 : 1);
+
+    auto fastConverter = SoapySDR::ConverterRegistry::getFunction(
+        source,
+        target,
+        SoapyVOLKConverters::FastPriority);
+
+    int32_t output[numScalars];
+    fastConverter(inputs, output, numElems, TestUtility::F32ToS32Scalar);
+
+    for (size_t i = 0; i < numScalars; ++i)
+    {
+        const int32_t expected = (inputs[i] > 0) ? positiveLimit : std::numeric_limits<int32_t>::min();
+        if (output[i] != expected)
+        {
+            std::cerr << " * " << double(inputs[i]) << " converted to " << output[i] << ", expected " << expected << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Checks a fast-tier integer converter maps NaN of either sign to the
+// minimum integer, and infinities to the limits it saturates to.
+template <typename InType, typename OutType>
+bool testFastNonFinite(
+    const std::string& source,
+    const std::string& target,
+    const double scalar)
+{
+    static constexpr OutType positiveLimit = (sizeof(OutType) < sizeof(int32_t)) ? std::numeric_limits<OutType>::max() : OutType(2147483520);
+    static const InType inputs[] =
+    {
+        std::numeric_limits<InType>::quiet_NaN(),
+        -std::numeric_limits<InType>::quiet_NaN(),
+        std::numeric_limits<InType>::infinity(),
+        -std::numeric_limits<InType>::infinity()
+    };
+    static const OutType expected[] = {std::numeric_limits<OutType>::min(), std::numeric_limits<OutType>::min(), positiveLimit, std::numeric_limits<OutType>::min()};
+    static constexpr size_t numScalars = sizeof(inputs) / sizeof(inputs[0]);
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing fast " << source << " -> " << target << " NaN and infinity..." << std::endl;
+
+    const size_t numElems = numScalars / ((source[0] == 'C') ? 2 : 1);
+
+    auto fastConverter = SoapySDR::ConverterRegistry::getFunction(
+        source,
+        target,
+        SoapyVOLKConverters::FastPriority);
+
+    OutType output[numScalars];
+    fastConverter(inputs, output, numElems, scalar);
+
+    for (size_t i = 0; i < numScalars; ++i)
+    {
+        if (output[i] != expected[i])
+        {
+            std::cerr << " * " << double(inputs[i]) << " converted to " << int64_t(output[i]) << ", expected " << int64_t(expected[i]) << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool getStats(
+    const std::string& source,
+    const std::string& target,
+    SoapyVOLKConvertersStats& statsOut,
+    size_t* indexOut = nullptr)
+{
+    auto getStatsFcn = GET_MODULE_FUNCTION(SoapyVOLKConverters_getStats);
+
+    std::vector<SoapyVOLKConvertersStats> allStats(getStatsFcn(nullptr, 0));
+    getStatsFcn(allStats.data(), allStats.size());
+
+    for (size_t i = 0; i < allStats.size(); ++i)
+    {
+        const auto& stats = allStats[i];
+        if ((source == stats.sourceFormat) && (target == stats.targetFormat) && (stats.priority == SoapySDR::ConverterRegistry::VECTORIZED))
+        {
+            statsOut = stats;
+            if (indexOut) *indexOut = i;
+            return true;
+        }
+    }
+
+    std::cerr << " * No statistics for " << source << " -> " << target << std::endl;
+    return false;
+}
+
+// Checks that calls from several threads are all counted, and that nothing
+// is counted while statistics are disabled.
+bool testStats()
+{
+    static constexpr size_t numElements = 1024;
+    static constexpr size_t numCallsPerThread = 100;
+    static constexpr size_t numThreads = 4;
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing converter statistics..." << std::endl;
+
+    auto resetStats = GET_MODULE_FUNCTION(SoapyVOLKConverters_resetStats);
+    auto setStatsEnabled = GET_MODULE_FUNCTION(SoapyVOLKConverters_setStatsEnabled);
+
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_CS16,
+        SOAPY_SDR_CF32,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+
+    const auto input = TestUtility::getRandomValues<std::complex<int16_t>>(numElements);
+    auto convert = [&]()
+    {
+        volk::vector<std::complex<float>> output(numElements);
+        for (size_t i = 0; i < numCallsPerThread; ++i)
+        {
+            converter(input.data(), output.data(), numElements, TestUtility::S16ToF32Scalar);
+        }
+    };
+
+    resetStats();
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i) threads.emplace_back(convert);
+    for (auto& thread: threads) thread.join();
+
+    // Counted on this thread while it's still running
+    convert();
+
+    setStatsEnabled(false);
+    convert();
+    setStatsEnabled(true);
+
+    SoapyVOLKConvertersStats stats;
+    if (!getStats(SOAPY_SDR_CS16, SOAPY_SDR_CF32, stats)) return false;
+
+    const uint64_t expectedCalls = (numThreads + 1) * numCallsPerThread;
+    const uint64_t expectedBytes = expectedCalls * numElements * (sizeof(std::complex<int16_t>) + sizeof(std::complex<float>));
+
+    std::cout << " * " << stats.calls << " calls, " << stats.elements << " elements, "
+              << stats.bytes << " bytes, " << stats.nanoseconds << " ns" << std::endl;
+
+    if ((stats.calls != expectedCalls) || (stats.elements != (expectedCalls * numElements)) || (stats.bytes != expectedBytes))
+    {
+        std::cerr << " * Expected " << expectedCalls << " calls, " << (expectedCalls * numElements) << " elements, "
+                  << expectedBytes << " bytes" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Checks that each call lands in its buffer size class, and that quantiles
+// are ordered.
+bool testLatencyHistograms()
+{
+    static const std::vector<size_t> bufferSizes{100, 1000, 5000, 70000};
+    static constexpr size_t numCallsPerSize = 50;
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing latency histograms..." << std::endl;
+
+    auto resetStats = GET_MODULE_FUNCTION(SoapyVOLKConverters_resetStats);
+    auto getNumSizeClasses = GET_MODULE_FUNCTION(SoapyVOLKConverters_getNumSizeClasses);
+    auto getSizeClassMinElems = GET_MODULE_FUNCTION(SoapyVOLKConverters_getSizeClassMinElems);
+    auto getNumLatencyBuckets = GET_MODULE_FUNCTION(SoapyVOLKConverters_getNumLatencyBuckets);
+    auto getLatencyHistogram = GET_MODULE_FUNCTION(SoapyVOLKConverters_getLatencyHistogram);
+    auto getLatencyQuantileNs = GET_MODULE_FUNCTION(SoapyVOLKConverters_getLatencyQuantileNs);
+
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS16,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+
+    const auto input = TestUtility::getRandomValues<std::complex<float>>(bufferSizes.back());
+    volk::vector<std::complex<int16_t>> output(bufferSizes.back());
+
+    resetStats();
+    for (const auto bufferSize: bufferSizes)
+    {
+        for (size_t i = 0; i < numCallsPerSize; ++i)
+        {
+            converter(input.data(), output.data(), bufferSize, TestUtility::F32ToS16Scalar);
+        }
+    }
+
+    SoapyVOLKConvertersStats stats;
+    size_t index = 0;
+    if (!getStats(SOAPY_SDR_CF32, SOAPY_SDR_CS16, stats, &index)) return false;
+
+    std::vector<uint64_t> counts(getNumLatencyBuckets());
+    for (size_t sizeClass = 0; sizeClass < getNumSizeClasses(); ++sizeClass)
+    {
+        const size_t minElems = getSizeClassMinElems(sizeClass);
+        const size_t maxElems = ((sizeClass + 1) < getNumSizeClasses()) ? getSizeClassMinElems(sizeClass + 1) : SIZE_MAX;
+        const uint64_t expectedCalls = numCallsPerSize * std::count_if(
+            bufferSizes.begin(),
+            bufferSizes.end(),
+            [&](size_t bufferSize) { return (bufferSize >= minElems) && (bufferSize < maxElems); });
+
+        if (!getLatencyHistogram(index, sizeClass, counts.data()))
+        {
+            std::cerr << " * Failed to get histogram for size class " << sizeClass << std::endl;
+            return false;
+        }
+
+        uint64_t calls = 0;
+        for (const auto count: counts) calls += count;
+        if (calls != expectedCalls)
+        {
+            std::cerr << " * Size class " << minElems << "+: " << calls << " calls, expected " << expectedCalls << std::endl;
+            return false;
+        }
+        if (calls == 0) continue;
+
+        const double p50 = getLatencyQuantileNs(index, sizeClass, 0.5);
+        const double p99 = getLatencyQuantileNs(index, sizeClass, 0.99);
+        std::cout << " * " << minElems << "+ elements: p50 " << p50 << " ns, p99 " << p99 << " ns" << std::endl;
+
+        if (!(p50 > 0.0) || !(p99 >= p50))
+        {
+            std::cerr << " * Invalid quantiles" << std::endl;
+            return false;
+        }
+    }
+
+    if (!std::isnan(getLatencyQuantileNs(index, getNumSizeClasses() - 1, 0.5)))
+    {
+        std::cerr << " * Expected no calls of 1M+ elements" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static std::string getMetricsText()
+{
+    auto getMetricsTextFcn = GET_MODULE_FUNCTION(SoapyVOLKConverters_getMetricsText);
+
+    std::vector<char> text(getMetricsTextFcn(nullptr, 0) + 1);
+    getMetricsTextFcn(text.data(), text.size());
+
+    return text.data();
+}
+
+// Checks each fallback path and saturation is counted for the call that took
+// it, and that the counts are published.
+bool testFallbackStats()
+{
+    static constexpr size_t numElements = 4096;
+    static constexpr size_t numSaturated = 20;
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing fallback path and saturation statistics..." << std::endl;
+
+    auto resetStats = GET_MODULE_FUNCTION(SoapyVOLKConverters_resetStats);
+    auto setSaturationCountingEnabled = GET_MODULE_FUNCTION(SoapyVOLKConverters_setSaturationCountingEnabled);
+
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S16,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+
+    // Out of range samples in the middle, so every call but the small one
+    // includes them.
+    volk::vector<float> input(numElements, 0.5f);
+    std::fill_n(input.begin() + 2000, numSaturated / 2, 2.0f);
+    std::fill_n(input.begin() + 2010, numSaturated / 2, -2.0f);
+
+    auto sparseInput = input;
+    std::fill_n(sparseInput.begin(), SoapyVOLKConverters::ZeroSkipBlockSize / sizeof(float), 0.0f);
+
+    volk::vector<int16_t> output(numElements);
+
+    resetStats();
+    setSaturationCountingEnabled(true);
+
+    converter(input.data(), output.data(), numElements, TestUtility::F32ToS16Scalar);
+    converter(input.data() + 1, output.data() + 1, numElements - 1, TestUtility::F32ToS16Scalar);
+    converter(input.data(), output.data(), SoapyVOLKConverters::SmallBufferElems - 1, TestUtility::F32ToS16Scalar);
+    converter(sparseInput.data(), output.data(), numElements, TestUtility::F32ToS16Scalar);
+
+    setSaturationCountingEnabled(false);
+
+    SoapyVOLKConvertersStats stats;
+    if (!getStats(SOAPY_SDR_F32, SOAPY_SDR_S16, stats)) return false;
+
+    std::cout << " * " << stats.unalignedCalls << " unaligned, " << stats.smallBufferCalls << " small-buffer, "
+              << stats.zeroSkipCalls << " zero-skip calls, " << stats.saturatedSamples << " saturated samples" << std::endl;
+
+    if ((stats.calls != 4) || (stats.unalignedCalls != 1) || (stats.smallBufferCalls != 1) || (stats.zeroSkipCalls != 1) || (stats.saturatedSamples != (3 * numSaturated)))
+    {
+        std::cerr << " * Expected 4 calls, 1 of each fallback path, 1 zero-skip call, and " << (3 * numSaturated) << " saturated samples" << std::endl;
+        return false;
+    }
+
+    const std::string expectedMetric =
+        "soapy_volk_converter_fallback_calls_total{source=\"" + std::string(SOAPY_SDR_F32) +
+        "\",target=\"" + std::string(SOAPY_SDR_S16) +
+        "\",priority=\"" + std::to_string(int(SoapySDR::ConverterRegistry::VECTORIZED)) +
+        "\",path=\"unaligned\"} 1\n";
+    if (getMetricsText().find(expectedMetric) == std::string::npos)
+    {
+        std::cerr << " * Metrics don't contain: " << expectedMetric;
+        return false;
+    }
+
+    // Saturated samples are only published while they're counted.
+    const std::string saturatedMetric = "soapy_volk_converter_saturated_samples_total{";
+    if (getMetricsText().find(saturatedMetric) != std::string::npos)
+    {
+        std::cerr << " * Metrics contain " << saturatedMetric << " with saturation counting disabled" << std::endl;
+        return false;
+    }
+
+    setSaturationCountingEnabled(true);
+    const bool published = (getMetricsText().find(saturatedMetric) != std::string::npos);
+    setSaturationCountingEnabled(false);
+    if (!published)
+    {
+        std::cerr << " * Metrics don't contain " << saturatedMetric << " with saturation counting enabled" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Only runs when the module was loaded with SOAPY_VOLK_METRICS set to a file,
+// as in the TestSoapyVOLKConvertersInstrumented test. Checks the file is
+// refreshed with the current counts.
+bool testMetricsPublishing()
+{
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing metrics publishing..." << std::endl;
+
+    const char* path = std::getenv("SOAPY_VOLK_METRICS");
+    const char* intervalMs = std::getenv("SOAPY_VOLK_METRICS_INTERVAL_MS");
+    if (!path || !intervalMs)
+    {
+        std::cout << " * SOAPY_VOLK_METRICS and SOAPY_VOLK_METRICS_INTERVAL_MS not set, skipping" << std::endl;
+        return true;
+    }
+
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_CS16,
+        SOAPY_SDR_CF64,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+
+    const auto input = TestUtility::getRandomValues<std::complex<int16_t>>(1024);
+    volk::vector<std::complex<double>> output(input.size());
+    converter(input.data(), output.data(), input.size(), TestUtility::S16ToF32Scalar);
+
+    const std::string expectedMetric =
+        "soapy_volk_converter_calls_total{source=\"" + std::string(SOAPY_SDR_CS16) +
+        "\",target=\"" + std::string(SOAPY_SDR_CF64) +
+        "\",priority=\"" + std::to_string(int(SoapySDR::ConverterRegistry::VECTORIZED)) + "\"} ";
+
+    // Other tests reset the counts, so only check this call shows up.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(10 * std::atoi(intervalMs));
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::atoi(intervalMs)));
+
+        std::ifstream file(path);
+        const std::string metrics((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        const size_t pos = metrics.find(expectedMetric);
+        if ((pos != std::string::npos) && (metrics[pos + expectedMetric.size()] != '0'))
+        {
+            std::cout << " * " << path << " updated" << std::endl;
+            return true;
+        }
+    }
+
+    std::cerr << " * " << path << " doesn't contain a nonzero " << expectedMetric << std::endl;
+    return false;
+}
+
+// Checks that each stage of a two-stage converter is timed, within the time
+// of the call as a whole.
+bool testStageTiming()
+{
+    static constexpr size_t numElements = 4096;
+    static constexpr size_t numCalls = 100;
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing stage timing..." << std::endl;
+
+    auto resetStats = GET_MODULE_FUNCTION(SoapyVOLKConverters_resetStats);
+    auto setStageTimingEnabled = GET_MODULE_FUNCTION(SoapyVOLKConverters_setStageTimingEnabled);
+
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_F64,
+        SOAPY_SDR_S16,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+
+    const auto input = TestUtility::getRandomValues<double>(numElements);
+    volk::vector<int16_t> output(numElements);
+
+    resetStats();
+
+    setStageTimingEnabled(true);
+    for (size_t i = 0; i < numCalls; ++i) converter(input.data(), output.data(), numElements, TestUtility::F32ToS16Scalar);
+    setStageTimingEnabled(false);
+    converter(input.data(), output.data(), numElements, TestUtility::F32ToS16Scalar);
+
+    SoapyVOLKConvertersStats stats;
+    if (!getStats(SOAPY_SDR_F64, SOAPY_SDR_S16, stats)) return false;
+
+    const uint64_t stageNanoseconds = stats.allocNanoseconds + stats.firstStageNanoseconds + stats.secondStageNanoseconds;
+
+    std::cout << " * " << stats.stageTimedCalls << " of " << stats.calls << " calls timed: alloc "
+              << stats.allocNanoseconds << " ns, first stage " << stats.firstStageNanoseconds
+              << " ns, second stage " << stats.secondStageNanoseconds << " ns, total " << stats.nanoseconds << " ns" << std::endl;
+
+    if ((stats.calls != (numCalls + 1)) || (stats.stageTimedCalls != numCalls))
+    {
+        std::cerr << " * Expected " << numCalls << " of " << (numCalls + 1) << " calls timed" << std::endl;
+        return false;
+    }
+    if ((stats.firstStageNanoseconds == 0) || (stats.secondStageNanoseconds == 0) || (stageNanoseconds > stats.nanoseconds))
+    {
+        std::cerr << " * Expected nonzero kernel stages within the total" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Checks that F64 converters count their intermediate buffers, and that
+// single-stage converters don't allocate.
+bool testAllocationStats()
+{
+    static const std::vector<size_t> numElementsPerCall{1024, 4096, 2048};
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing allocation statistics..." << std::endl;
+
+    auto resetStats = GET_MODULE_FUNCTION(SoapyVOLKConverters_resetStats);
+
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_F64,
+        SOAPY_SDR_S16,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+    auto singleStageConverter = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S16,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+
+    const auto input = TestUtility::getRandomValues<double>(numElementsPerCall[1]);
+    const auto singleStageInput = TestUtility::getRandomValues<float>(numElementsPerCall[1]);
+    volk::vector<int16_t> output(numElementsPerCall[1]);
+
+    resetStats();
+
+    for (const size_t numElements: numElementsPerCall)
+    {
+        converter(input.data(), output.data(), numElements, TestUtility::F32ToS16Scalar);
+        singleStageConverter(singleStageInput.data(), output.data(), numElements, TestUtility::F32ToS16Scalar);
+    }
+
+    SoapyVOLKConvertersStats stats, singleStageStats;
+    if (!getStats(SOAPY_SDR_F64, SOAPY_SDR_S16, stats)) return false;
+    if (!getStats(SOAPY_SDR_F32, SOAPY_SDR_S16, singleStageStats)) return false;
+
+    std::cout << " * " << stats.allocations << " allocations, " << stats.allocatedBytes << " bytes, peak "
+              << stats.peakScratchBytes << " bytes" << std::endl;
+
+    const uint64_t expectedBytes = (numElementsPerCall[0] + numElementsPerCall[1] + numElementsPerCall[2]) * sizeof(float);
+    const uint64_t expectedPeakBytes = numElementsPerCall[1] * sizeof(float);
+    if ((stats.allocations != numElementsPerCall.size()) || (stats.allocatedBytes != expectedBytes) || (stats.peakScratchBytes != expectedPeakBytes))
+    {
+        std::cerr << " * Expected " << numElementsPerCall.size() << " allocations, " << expectedBytes
+                  << " bytes, peak " << expectedPeakBytes << " bytes" << std::endl;
+        return false;
+    }
+    if ((singleStageStats.allocations != 0) || (singleStageStats.peakScratchBytes != 0))
+    {
+        std::cerr << " * Expected no allocations from " << SOAPY_SDR_F32 << " -> " << SOAPY_SDR_S16 << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static bool hasImpl(const volk_func_desc_t& desc, const std::string& impl)
+{
+    for (size_t i = 0; i < desc.n_impls; ++i)
+    {
+        if (impl == desc.impl_names[i]) return true;
+    }
+
+    return false;
+}
+
+// Checks converters list the kernels they call, dispatched to implementations
+// VOLK has on this machine.
+bool testKernelInfo()
+{
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing kernel info..." << std::endl;
+
+    auto getKernelInfo = GET_MODULE_FUNCTION(SoapyVOLKConverters_getKernelInfo);
+
+    std::vector<SoapyVOLKConvertersKernelInfo> allInfo(getKernelInfo(nullptr, 0));
+    getKernelInfo(allInfo.data(), allInfo.size());
+
+    std::vector<std::string> cf64ToCS16Kernels;
+    for (const auto& info: allInfo)
+    {
+        if (info.priority != SoapySDR::ConverterRegistry::VECTORIZED) continue;
+
+        const std::string kernel = info.kernel;
+        if (kernel.empty())
+        {
+            std::cerr << " * " << info.sourceFormat << " -> " << info.targetFormat << " lists no kernels" << std::endl;
+            return false;
+        }
+        if ((std::string(SOAPY_SDR_CF64) == info.sourceFormat) && (std::string(SOAPY_SDR_CS16) == info.targetFormat))
+        {
+            cf64ToCS16Kernels.push_back(kernel);
+        }
+        if (kernel == "volk_32f_s32f_convert_16i")
+        {
+            const auto desc = volk_32f_s32f_convert_16i_get_func_desc();
+            if (!hasImpl(desc, info.alignedImpl) || !hasImpl(desc, info.unalignedImpl))
+            {
+                std::cerr << " * Unknown implementations " << info.alignedImpl << ", " << info.unalignedImpl << std::endl;
+                return false;
+            }
+        }
+    }
+
+    const std::vector<std::string> expectedKernels{"volk_64f_convert_32f", "volk_32f_s32f_convert_16i"};
+    if (cf64ToCS16Kernels != expectedKernels)
+    {
+        std::cerr << " * Expected " << SOAPY_SDR_CF64 << " -> " << SOAPY_SDR_CS16 << " to list "
+                  << expectedKernels[0] << " and " << expectedKernels[1] << std::endl;
+        return false;
+    }
+
+    std::cout << " * " << allInfo.size() << " converter kernels" << std::endl;
+
+    return true;
+}
+
+// Checks the module returns the same functions it registered with SoapySDR,
+// as it's the only module with these converters.
+bool testGetConverter()
+{
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing getting converters..." << std::endl;
+
+    auto getConverter = GET_MODULE_FUNCTION(SoapyVOLKConverters_getConverter);
+
+    const auto registered = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS16,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+    if (getConverter(SOAPY_SDR_CF32, SOAPY_SDR_CS16, SoapySDR::ConverterRegistry::VECTORIZED) != registered)
+    {
+        std::cerr << " * " << SOAPY_SDR_CF32 << " -> " << SOAPY_SDR_CS16 << " doesn't match the registered converter" << std::endl;
+        return false;
+    }
+    if (getConverter(SOAPY_SDR_CF32, SOAPY_SDR_CS16, SoapySDR::ConverterRegistry::GENERIC) != nullptr)
+    {
+        std::cerr << " * Got a converter at a priority the module doesn't register" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Only runs when the module was loaded with SOAPY_VOLK_TRACE set, as in the
+// TestSoapyVOLKConvertersInstrumented test. Checks that every call on another thread
+// is written as a begin/end pair.
+bool testTrace()
+{
+    static constexpr size_t numElements = 1000;
+    static constexpr size_t numCalls = 10000;
+
+    std::cout << "-----" << std::endl;
+    std::cout << "Testing tracing..." << std::endl;
+
+    auto getTraceEnabled = GET_MODULE_FUNCTION(SoapyVOLKConverters_getTraceEnabled);
+    auto writeTrace = GET_MODULE_FUNCTION(SoapyVOLKConverters_writeTrace);
+
+    if (!getTraceEnabled())
+    {
+        std::cout << " * SOAPY_VOLK_TRACE not set, skipping" << std::endl;
+        return true;
+    }
+
+    auto converter = SoapySDR::ConverterRegistry::getFunction(
+        SOAPY_SDR_CS8,
+        SOAPY_SDR_CF32,
+        SoapySDR::ConverterRegistry::VECTORIZED);
+
+    std::thread thread([&]()
+    {
+        const auto input = TestUtility::getRandomValues<std::complex<int8_t>>(numElements);
+        volk::vector<std::complex<float>> output(numElements);
+        for (size_t i = 0; i < numCalls; ++i)
+        {
+            converter(input.data(), output.data(), numElements, TestUtility::S8ToF32Scalar);
+        }
+    });
+    thread.join();
+
+    const std::string path = "TestSoapyVOLKConvertersTrace.json";
+    if (0 != writeTrace(path.c_str()))
+    {
+        std::cerr << " * Failed to write " << path << std::endl;
+        return false;
+    }
+
+    std::ifstream file(path);
+    const std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(path.c_str());
+
+    // Each begin event is on its own line, followed by its end event.
+    size_t numBegins = 0;
+    size_t numEnds = 0;
+    std::istringstream lines(trace);
+    std::string line;
+    bool expectEnd = false;
+    while (std::getline(lines, line))
+    {
+        if (expectEnd && (line.find("\"ph\":\"E\"") != std::string::npos)) ++numEnds;
+        expectEnd = (line.find("\"name\":\"CS8 -> CF32\",\"cat\":\"convert\",\"ph\":\"B\"") != std::string::npos) &&
+                    (line.find("\"numElems\":" + std::to_string(numElements)) != std::string::npos);
+        if (expectEnd) ++numBegins;
+    }
+
+    std::cout << " * " << numBegins << " begin events, " << numEnds << " end events" << std::endl;
+
+    if ((numBegins != numCalls) || (numEnds != numCalls) || (trace.compare(trace.size() - 4, 4, "\n]}\n") != 0))
+    {
+        std::cerr << " * Expected " << numCalls << " begin/end pairs in a complete trace" << std::endl;
+        return false;
+    }
 
     return true;
 }
@@ -123,155 +1106,411 @@ bool testConverterLoopback(
 // Main
 //
 
-int main(int, char**)
+// Loopback tests take an optional signal name, from TestUtility::getSignals(),
+// then an optional seed to reproduce a run.
+int main(int argc, char** argv)
 {
-    if (!TestUtility::loadSoapyVOLK()) return EXIT_FAILURE;
+    if (!ModuleLoader::loadSoapyVOLK()) return EXIT_FAILURE;
+
+    const auto signal = (argc > 1) ? TestUtility::getSignal(argv[1]) : TestUtility::Signal::Uniform;
+    if (argc > 2) TestUtility::setRandomSeed(std::stoull(argv[2]));
+
+    std::cout << "Loopback signal: " << TestUtility::getSignalName(signal) << std::endl;
+    std::cout << "Random seed:     " << TestUtility::getRandomSeed() << std::endl;
+
+    bool success = true;
 
     // int8_t
-    testConverterLoopback<int8_t, int16_t>(
+    success &= testConverterLoopback<int8_t, int16_t>(
         SOAPY_SDR_S8,
         SOAPY_SDR_S16,
-        1.0); // No scaling
-    testConverterLoopback<int8_t, float>(
+        1.0, // No scaling
+        signal);
+    success &= testConverterLoopback<int8_t, float>(
         SOAPY_SDR_S8,
         SOAPY_SDR_F32,
-        TestUtility::S8ToF32Scalar);
-    testConverterLoopback<int8_t, double>(
+        TestUtility::S8ToF32Scalar,
+        signal);
+    success &= testConverterLoopback<int8_t, double>(
         SOAPY_SDR_S8,
         SOAPY_SDR_F64,
-        TestUtility::S8ToF32Scalar);
+        TestUtility::S8ToF32Scalar,
+        signal);
 
     // int16_t
-    testConverterLoopback<int16_t, int8_t>(
+    success &= testConverterLoopback<int16_t, int8_t>(
         SOAPY_SDR_S16,
         SOAPY_SDR_S8,
-        1.0); // No scaling
-    testConverterLoopback<int16_t, float>(
+        1.0, // No scaling
+        signal);
+    success &= testConverterLoopback<int16_t, float>(
         SOAPY_SDR_S16,
         SOAPY_SDR_F32,
-        TestUtility::S16ToF32Scalar);
+        TestUtility::S16ToF32Scalar,
+        signal);
 
     // int32_t
-    testConverterLoopback<int32_t, float>(
+    success &= testConverterLoopback<int32_t, float>(
         SOAPY_SDR_S32,
         SOAPY_SDR_F32,
-        TestUtility::S32ToF32Scalar);
+        TestUtility::S32ToF32Scalar,
+        signal);
 
     // float
-    testConverterLoopback<float, int8_t>(
+    success &= testConverterLoopback<float, int8_t>(
         SOAPY_SDR_F32,
         SOAPY_SDR_S8,
-        TestUtility::F32ToS8Scalar);
-    testConverterLoopback<float, int16_t>(
+        TestUtility::F32ToS8Scalar,
+        signal);
+    success &= testConverterLoopback<float, int16_t>(
         SOAPY_SDR_F32,
         SOAPY_SDR_S16,
-        TestUtility::F32ToS16Scalar);
-    testConverterLoopback<float, int32_t>(
+        TestUtility::F32ToS16Scalar,
+        signal);
+    success &= testConverterLoopback<float, int32_t>(
         SOAPY_SDR_F32,
         SOAPY_SDR_S32,
-        TestUtility::F32ToS32Scalar);
-    testConverterLoopback<float, float>(
+        TestUtility::F32ToS32Scalar,
+        signal);
+    success &= testConverterLoopback<float, float>(
         SOAPY_SDR_F32,
         SOAPY_SDR_F32,
-        10.0);
-    testConverterLoopback<float, double>(
+        10.0,
+        signal);
+    success &= testConverterLoopback<float, double>(
         SOAPY_SDR_F32,
         SOAPY_SDR_F64,
-        10.0);
+        10.0,
+        signal);
 
     // double
-    testConverterLoopback<double, int8_t>(
+    success &= testConverterLoopback<double, int8_t>(
         SOAPY_SDR_F64,
         SOAPY_SDR_S8,
-        TestUtility::F32ToS8Scalar);
-    testConverterLoopback<double, int16_t>(
+        TestUtility::F32ToS8Scalar,
+        signal);
+    success &= testConverterLoopback<double, int16_t>(
         SOAPY_SDR_F64,
         SOAPY_SDR_S16,
-        TestUtility::F32ToS16Scalar);
-    testConverterLoopback<double, int32_t>(
+        TestUtility::F32ToS16Scalar,
+        signal);
+    success &= testConverterLoopback<double, int32_t>(
         SOAPY_SDR_F64,
         SOAPY_SDR_S32,
-        TestUtility::F32ToS32Scalar);
-    testConverterLoopback<double, float>(
+        TestUtility::F32ToS32Scalar,
+        signal);
+    success &= testConverterLoopback<double, float>(
         SOAPY_SDR_F64,
         SOAPY_SDR_F32,
-        10.0);
+        10.0,
+        signal);
 
     // std::complex<int8_t>
-    testConverterLoopback<std::complex<int8_t>, std::complex<int16_t>>(
+    success &= testConverterLoopback<std::complex<int8_t>, std::complex<int16_t>>(
         SOAPY_SDR_CS8,
         SOAPY_SDR_CS16,
-        1.0); // No scaling
-    testConverterLoopback<std::complex<int8_t>, std::complex<float>>(
+        1.0, // No scaling
+        signal);
+    success &= testConverterLoopback<std::complex<int8_t>, std::complex<float>>(
         SOAPY_SDR_CS8,
         SOAPY_SDR_CF32,
-        TestUtility::S8ToF32Scalar);
-    testConverterLoopback<std::complex<int8_t>, std::complex<double>>(
+        TestUtility::S8ToF32Scalar,
+        signal);
+    success &= testConverterLoopback<std::complex<int8_t>, std::complex<double>>(
         SOAPY_SDR_CS8,
         SOAPY_SDR_CF64,
-        TestUtility::S8ToF32Scalar);
+        TestUtility::S8ToF32Scalar,
+        signal);
 
     // std::complex<int16_t>
-    testConverterLoopback<std::complex<int16_t>, std::complex<int8_t>>(
+    success &= testConverterLoopback<std::complex<int16_t>, std::complex<int8_t>>(
         SOAPY_SDR_CS16,
         SOAPY_SDR_CS8,
-        1.0); // No scaling
-    testConverterLoopback<std::complex<int16_t>, std::complex<float>>(
+        1.0, // No scaling
+        signal);
+    success &= testConverterLoopback<std::complex<int16_t>, std::complex<float>>(
         SOAPY_SDR_CS16,
         SOAPY_SDR_CF32,
-        TestUtility::S16ToF32Scalar);
-    testConverterLoopback<std::complex<int16_t>, std::complex<double>>(
+        TestUtility::S16ToF32Scalar,
+        signal);
+    success &= testConverterLoopback<std::complex<int16_t>, std::complex<double>>(
         SOAPY_SDR_CS16,
         SOAPY_SDR_CF64,
-        TestUtility::S16ToF32Scalar);
+        TestUtility::S16ToF32Scalar,
+        signal);
 
     // std::complex<int32_t>
-    testConverterLoopback<std::complex<int32_t>, std::complex<float>>(
+    success &= testConverterLoopback<std::complex<int32_t>, std::complex<float>>(
         SOAPY_SDR_CS32,
         SOAPY_SDR_CF32,
-        TestUtility::S32ToF32Scalar);
+        TestUtility::S32ToF32Scalar,
+        signal);
 
     // std::complex<float>
-    testConverterLoopback<std::complex<float>, std::complex<int8_t>>(
+    success &= testConverterLoopback<std::complex<float>, std::complex<int8_t>>(
         SOAPY_SDR_CF32,
         SOAPY_SDR_CS8,
-        TestUtility::F32ToS8Scalar);
-    testConverterLoopback<std::complex<float>, std::complex<int16_t>>(
+        TestUtility::F32ToS8Scalar,
+        signal);
+    success &= testConverterLoopback<std::complex<float>, std::complex<int16_t>>(
         SOAPY_SDR_CF32,
         SOAPY_SDR_CS16,
-        TestUtility::F32ToS16Scalar);
-    testConverterLoopback<std::complex<float>, std::complex<int32_t>>(
+        TestUtility::F32ToS16Scalar,
+        signal);
+    success &= testConverterLoopback<std::complex<float>, std::complex<int32_t>>(
         SOAPY_SDR_CF32,
         SOAPY_SDR_CS32,
-        TestUtility::F32ToS32Scalar);
-    testConverterLoopback<std::complex<float>, std::complex<float>>(
+        TestUtility::F32ToS32Scalar,
+        signal);
+    success &= testConverterLoopback<std::complex<float>, std::complex<float>>(
         SOAPY_SDR_CF32,
         SOAPY_SDR_CF32,
-        10.0);
-    testConverterLoopback<std::complex<float>, std::complex<double>>(
+        10.0,
+        signal);
+    success &= testConverterLoopback<std::complex<float>, std::complex<double>>(
         SOAPY_SDR_CF32,
         SOAPY_SDR_CF64,
-        10.0);
+        10.0,
+        signal);
 
     // std::complex<double>
-    testConverterLoopback<std::complex<double>, std::complex<int8_t>>(
+    success &= testConverterLoopback<std::complex<double>, std::complex<int8_t>>(
         SOAPY_SDR_CF64,
         SOAPY_SDR_CS8,
-        TestUtility::F32ToS8Scalar);
-    testConverterLoopback<std::complex<double>, std::complex<int16_t>>(
+        TestUtility::F32ToS8Scalar,
+        signal);
+    success &= testConverterLoopback<std::complex<double>, std::complex<int16_t>>(
         SOAPY_SDR_CF64,
         SOAPY_SDR_CS16,
-        TestUtility::F32ToS16Scalar);
-    testConverterLoopback<std::complex<double>, std::complex<int32_t>>(
+        TestUtility::F32ToS16Scalar,
+        signal);
+    success &= testConverterLoopback<std::complex<double>, std::complex<int32_t>>(
+        SOAPY_SDR_CF64,
+        SOAPY_SDR_CS32,
+        TestUtility::F32ToS32Scalar,
+        signal);
+    success &= testConverterLoopback<std::complex<double>, std::complex<float>>(
         SOAPY_SDR_CF64,
+        SOAPY_SDR_CF32,
+        10.0,
+        signal);
+
+
+    // TX zero-skip
+    success &= testZeroSkip<int8_t>(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S8,
+        TestUtility::F32ToS8Scalar,
+        volk_32f_s32f_convert_8i);
+    success &= testZeroSkip<int16_t>(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S16,
+        TestUtility::F32ToS16Scalar,
+        volk_32f_s32f_convert_16i);
+    success &= testZeroSkip<int32_t>(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S32,
+        TestUtility::F32ToS32Scalar,
+        volk_32f_s32f_convert_32i);
+    success &= testZeroSkip<int8_t>(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS8,
+        TestUtility::F32ToS8Scalar,
+        volk_32f_s32f_convert_8i);
+    success &= testZeroSkip<int16_t>(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS16,
+        TestUtility::F32ToS16Scalar,
+        volk_32f_s32f_convert_16i);
+    success &= testZeroSkip<int32_t>(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS32,
+        TestUtility::F32ToS32Scalar,
+        volk_32f_s32f_convert_32i);
+
+    // Signals
+    success &= testSignalFeatures();
+    success &= testSignalConversion<float, int8_t>(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S8,
+        TestUtility::F32ToS8Scalar,
+        volk_32f_s32f_convert_8i);
+    success &= testSignalConversion<float, int16_t>(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S16,
+        TestUtility::F32ToS16Scalar,
+        volk_32f_s32f_convert_16i);
+    success &= testSignalConversion<float, int32_t>(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S32,
+        TestUtility::F32ToS32Scalar,
+        volk_32f_s32f_convert_32i);
+    success &= testSignalConversion<double, int8_t>(
+        SOAPY_SDR_F64,
+        SOAPY_SDR_S8,
+        TestUtility::F32ToS8Scalar,
+        volk_32f_s32f_convert_8i);
+    success &= testSignalConversion<double, int16_t>(
+        SOAPY_SDR_F64,
+        SOAPY_SDR_S16,
+        TestUtility::F32ToS16Scalar,
+        volk_32f_s32f_convert_16i);
+    success &= testSignalConversion<double, int32_t>(
+        SOAPY_SDR_F64,
+        SOAPY_SDR_S32,
+        TestUtility::F32ToS32Scalar,
+        volk_32f_s32f_convert_32i);
+    success &= testSignalConversion<float, int8_t>(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS8,
+        TestUtility::F32ToS8Scalar,
+        volk_32f_s32f_convert_8i);
+    success &= testSignalConversion<float, int16_t>(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS16,
+        TestUtility::F32ToS16Scalar,
+        volk_32f_s32f_convert_16i);
+    success &= testSignalConversion<float, int32_t>(
+        SOAPY_SDR_CF32,
         SOAPY_SDR_CS32,
-        TestUtility::F32ToS32Scalar);
-    testConverterLoopback<std::complex<double>, std::complex<float>>(
+        TestUtility::F32ToS32Scalar,
+        volk_32f_s32f_convert_32i);
+    success &= testSignalConversion<double, int8_t>(
         SOAPY_SDR_CF64,
+        SOAPY_SDR_CS8,
+        TestUtility::F32ToS8Scalar,
+        volk_32f_s32f_convert_8i);
+    success &= testSignalConversion<double, int16_t>(
+        SOAPY_SDR_CF64,
+        SOAPY_SDR_CS16,
+        TestUtility::F32ToS16Scalar,
+        volk_32f_s32f_convert_16i);
+    success &= testSignalConversion<double, int32_t>(
+        SOAPY_SDR_CF64,
+        SOAPY_SDR_CS32,
+        TestUtility::F32ToS32Scalar,
+        volk_32f_s32f_convert_32i);
+
+    success &= testStats();
+    success &= testLatencyHistograms();
+    success &= testFallbackStats();
+    success &= testStageTiming();
+    success &= testAllocationStats();
+    success &= testKernelInfo();
+    success &= testGetConverter();
+    success &= testTrace();
+    success &= testMetricsPublishing();
+
+    // Fast tier. Float inputs to S32 stay in range, as the exact converter's
+    // saturation at +full scale is implementation-defined.
+    success &= testFastConverter<float, int8_t>(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S8,
+        TestUtility::F32ToS8Scalar,
+        1.5);
+    success &= testFastConverter<float, int16_t>(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S16,
+        TestUtility::F32ToS16Scalar,
+        1.5);
+    success &= testFastConverter<float, int32_t>(
+        SOAPY_SDR_F32,
+        SOAPY_SDR_S32,
+        TestUtility::F32ToS32Scalar,
+        0.99);
+    success &= testFastConverter<double, int8_t>(
+        SOAPY_SDR_F64,
+        SOAPY_SDR_S8,
+        TestUtility::F32ToS8Scalar,
+        1.5);
+    success &= testFastConverter<double, int16_t>(
+        SOAPY_SDR_F64,
+        SOAPY_SDR_S16,
+        TestUtility::F32ToS16Scalar,
+        1.5);
+    success &= testFastConverter<double, int32_t>(
+        SOAPY_SDR_F64,
+        SOAPY_SDR_S32,
+        TestUtility::F32ToS32Scalar,
+        0.99);
+    success &= testFastConverter<int8_t, double>(
+        SOAPY_SDR_S8,
+        SOAPY_SDR_F64,
+        TestUtility::S8ToF32Scalar,
+        0.0);
+    success &= testFastConverter<int16_t, double>(
+        SOAPY_SDR_S16,
+        SOAPY_SDR_F64,
+        TestUtility::S16ToF32Scalar,
+        0.0);
+    success &= testFastConverter<int32_t, double>(
+        SOAPY_SDR_S32,
+        SOAPY_SDR_F64,
+        TestUtility::S32ToF32Scalar,
+        0.0);
+    success &= testFastConverter<float, int8_t>(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS8,
+        TestUtility::F32ToS8Scalar,
+        1.5);
+    success &= testFastConverter<float, int16_t>(
+        SOAPY_SDR_CF32,
+        SOAPY_SDR_CS16,
+        TestUtility::F32ToS16Scalar,
+        1.5);
+    success &= testFastConverter<float, int32_t>(
         SOAPY_SDR_CF32,
-        10.0);
+        SOAPY_SDR_CS32,
+        TestUtility::F32ToS32Scalar,
+        0.99);
+    success &= testFastConverter<double, int8_t>(
+        SOAPY_SDR_CF64,
+        SOAPY_SDR_CS8,
+        TestUtility::F32ToS8Scalar,
+        1.5);
+    success &= testFastConverter<double, int16_t>(
+        SOAPY_SDR_CF64,
+        SOAPY_SDR_CS16,
+        TestUtility::F32ToS16Scalar,
+        1.5);
+    success &= testFastConverter<double, int32_t>(
+        SOAPY_SDR_CF64,
+        SOAPY_SDR_CS32,
+        TestUtility::F32ToS32Scalar,
+        0.99);
+    success &= testFastConverter<int8_t, double>(
+        SOAPY_SDR_CS8,
+        SOAPY_SDR_CF64,
+        TestUtility::S8ToF32Scalar,
+        0.0);
+    success &= testFastConverter<int16_t, double>(
+        SOAPY_SDR_CS16,
+        SOAPY_SDR_CF64,
+        TestUtility::S16ToF32Scalar,
+        0.0);
+    success &= testFastConverter<int32_t, double>(
+        SOAPY_SDR_CS32,
+        SOAPY_SDR_CF64,
+        TestUtility::S32ToF32Scalar,
+        0.0);
+    success &= testFastS32Saturation<float>(SOAPY_SDR_F32, SOAPY_SDR_S32);
+    success &= testFastS32Saturation<double>(SOAPY_SDR_F64, SOAPY_SDR_S32);
+    success &= testFastS32Saturation<float>(SOAPY_SDR_CF32, SOAPY_SDR_CS32);
+    success &= testFastS32Saturation<double>(SOAPY_SDR_CF64, SOAPY_SDR_CS32);
+    success &= testFastNonFinite<float, int8_t>(SOAPY_SDR_F32, SOAPY_SDR_S8, TestUtility::F32ToS8Scalar);
+    success &= testFastNonFinite<float, int16_t>(SOAPY_SDR_F32, SOAPY_SDR_S16, TestUtility::F32ToS16Scalar);
+    success &= testFastNonFinite<float, int32_t>(SOAPY_SDR_F32, SOAPY_SDR_S32, TestUtility::F32ToS32Scalar);
+    success &= testFastNonFinite<double, int8_t>(SOAPY_SDR_F64, SOAPY_SDR_S8, TestUtility::F32ToS8Scalar);
+    success &= testFastNonFinite<double, int16_t>(SOAPY_SDR_F64, SOAPY_SDR_S16, TestUtility::F32ToS16Scalar);
+    success &= testFastNonFinite<double, int32_t>(SOAPY_SDR_F64, SOAPY_SDR_S32, TestUtility::F32ToS32Scalar);
+    success &= testFastNonFinite<float, int8_t>(SOAPY_SDR_CF32, SOAPY_SDR_CS8, TestUtility::F32ToS8Scalar);
+    success &= testFastNonFinite<float, int16_t>(SOAPY_SDR_CF32, SOAPY_SDR_CS16, TestUtility::F32ToS16Scalar);
+    success &= testFastNonFinite<float, int32_t>(SOAPY_SDR_CF32, SOAPY_SDR_CS32, TestUtility::F32ToS32Scalar);
+    success &= testFastNonFinite<double, int8_t>(SOAPY_SDR_CF64, SOAPY_SDR_CS8, TestUtility::F32ToS8Scalar);
+    success &= testFastNonFinite<double, int16_t>(SOAPY_SDR_CF64, SOAPY_SDR_CS16, TestUtility::F32ToS16Scalar);
+    success &= testFastNonFinite<double, int32_t>(SOAPY_SDR_CF64, SOAPY_SDR_CS32, TestUtility::F32ToS32Scalar);
 
     std::cout << "-----" << std::endl;
 
-    return EXIT_SUCCESS;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file
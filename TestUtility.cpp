@@ -1,69 +1,261 @@
 // Copyright (c) 2021 Nicholas Corgan
 // SPDX-License-Identifier: GPL-3.0
 
-#include "config.h"
 #include "TestUtility.hpp"
 
-#include <SoapySDR/Modules.hpp>
-
+#include <cmath>
 #include <cstdlib>
-#include <iostream>
+#include <fstream>
 #include <stdexcept>
 
 #if defined _WIN32 || defined __CYGWIN__
 #define IS_WIN32
 
-#include <direct.h> // _getcwd
-
-#define getcwd _getcwd
+#define NOMINMAX
+#include <windows.h> // SetThreadAffinityMask
+#include <psapi.h> // GetProcessMemoryInfo
 #else
 #define IS_UNIX
 
-#include <unistd.h> // getcwd
-#endif
-
-#ifndef MAX_PATH
-#define MAX_PATH 256
+#include <pthread.h> // pthread_setaffinity_np
+#include <sched.h> // cpu_set_t
+#include <sys/resource.h> // getrusage
 #endif
 
 // TODO: MinGW
 namespace TestUtility
 {
-    bool loadSoapyVOLK()
+    bool pinThreadToCore(size_t core)
     {
-        try
-        {
-            std::string basename;
-            std::string extension;
-            std::string separator;
-            std::string subpath;
+#if defined(IS_WIN32)
+        if (core >= (sizeof(DWORD_PTR) * 8)) return false;
+        return (SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR(1) << core)) != 0);
+#elif defined(__linux__)
+        if (core >= CPU_SETSIZE) return false;
 
-            char cwd[MAX_PATH] = {0};
-            char* _ = getcwd(cwd, sizeof(cwd)); // Suppress Clang warning
-            (void)_;
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(core, &cpus);
+        return (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0);
+#else
+        // macOS only takes affinity hints.
+        (void)core;
+        return false;
+#endif
+    }
 
+    size_t getPeakRSSBytes()
+    {
 #ifdef IS_WIN32
-            basename = "volkConverters";
-            extension = ".dll";
-            separator = "\\";
-            subpath = cwd + separator + CMAKE_BUILD_TYPE;
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+
+#ifdef __APPLE__
+        return size_t(usage.ru_maxrss);
 #else
-            basename = "libvolkConverters";
-            extension = ".so";
-            separator = "/";
-            subpath.assign(cwd);
+        // Kilobytes everywhere but macOS
+        return size_t(usage.ru_maxrss) * 1024;
+#endif
 #endif
-            const std::string filepath = subpath + separator + basename + extension;
-            std::cout << "Loading " << filepath << "..." << std::endl;
-            SoapySDR::loadModule(filepath);
-            std::cout << "Loaded version " << SoapySDR::getModuleVersion(filepath) << std::endl;
+    }
+
+    //
+    // Random values
+    //
+
+    static uint64_t splitMix64(uint64_t& state)
+    {
+        uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    RandomGenerator::RandomGenerator(uint64_t seed)
+    {
+        this->seed(seed);
+    }
+
+    void RandomGenerator::seed(uint64_t seed)
+    {
+        // Consecutive splitmix64 outputs are never all zero, which is
+        // xoshiro's one invalid state.
+        uint64_t splitMixState = seed;
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            for (auto& word: _state) word[lane] = splitMix64(splitMixState);
         }
-        catch (const std::exception& ex)
+
+        _next = Lanes;
+    }
+
+    static uint64_t randomSeed = (uint64_t(std::random_device()()) << 32) | std::random_device()();
+
+    RandomGenerator& getRandomGenerator()
+    {
+        static RandomGenerator generator(randomSeed);
+        return generator;
+    }
+
+    void setRandomSeed(uint64_t seed)
+    {
+        randomSeed = seed;
+        getRandomGenerator().seed(seed);
+    }
+
+    uint64_t getRandomSeed()
+    {
+        return randomSeed;
+    }
+
+    //
+    // Signals
+    //
+
+    static const std::vector<std::pair<Signal, std::string>> SignalNames =
+    {
+        {Signal::Uniform, "uniform"},
+        {Signal::Tone, "tone"},
+        {Signal::NoisyTone, "noisy_tone"},
+        {Signal::ClippedBurst, "clipped_burst"},
+        {Signal::SparseZeros, "sparse_zeros"},
+        {Signal::DenormalDecay, "denormal_decay"},
+        {Signal::FullScaleEdges, "full_scale_edges"}
+    };
+
+    const std::vector<Signal>& getSignals()
+    {
+        static std::vector<Signal> signals;
+        if (signals.empty())
         {
-            std::cerr << "Exception loading module: " << ex.what() << std::endl;
-            return false;
+            for (const auto& signalName: SignalNames) signals.push_back(signalName.first);
         }
 
-        return true;
+        return signals;
+    }
+
+    std::string getSignalName(Signal signal)
+    {
+        for (const auto& signalName: SignalNames)
+        {
+            if (signalName.first == signal) return signalName.second;
+        }
+
+        throw std::invalid_argument("getSignalName: invalid signal");
+    }
+
+    Signal getSignal(const std::string& name)
+    {
+        for (const auto& signalName: SignalNames)
+        {
+            if (signalName.second == name) return signalName.first;
+        }
+
+        throw std::invalid_argument("Unknown signal " + name);
+    }
+
+    // Not a multiple of any SIMD width, or a divisor of a buffer size
+    static constexpr double ToneCyclesPerSample = 0.0123;
+    static constexpr double Pi = 3.14159265358979323846;
+
+    static std::complex<double> getTone(size_t index, double amplitude)
+    {
+        return std::polar(amplitude, 2.0 * Pi * ToneCyclesPerSample * double(index));
+    }
+
+    // Per component, so a complex tone's power over the noise's is the SNR,
+    // and the same holds for a real tone and the real part of the noise.
+    static std::complex<double> getNoise(double amplitude, double snrDB)
+    {
+        std::normal_distribution<double> dist(0.0, amplitude / std::sqrt(2.0) * std::pow(10.0, -snrDB / 20.0));
+        auto& generator = getRandomGenerator();
+        const double real = dist(generator);
+        return std::complex<double>(real, dist(generator));
+    }
+
+    std::complex<double> getSignalSample(
+        Signal signal,
+        size_t index,
+        size_t numElements,
+        double snrDB,
+        double decayFloor)
+    {
+        // Bursts start and end mid-block, so only some of a burst's blocks
+        // are zero.
+        static constexpr size_t BurstLength = 700;
+        static constexpr size_t BurstPeriod = 3000;
+
+        switch (signal)
+        {
+        case Signal::Tone:
+            return getTone(index, 0.7);
+
+        case Signal::NoisyTone:
+            return getTone(index, 0.5) + getNoise(0.5, snrDB);
+
+        case Signal::ClippedBurst:
+            if ((index % BurstPeriod) < BurstLength) return getTone(index, 1.5);
+            return getNoise(0.01, 0.0);
+
+        case Signal::SparseZeros:
+            if ((index % BurstPeriod) < BurstLength) return getTone(index, 0.5) + getNoise(0.5, snrDB);
+            return 0.0;
+
+        case Signal::DenormalDecay:
+        {
+            static constexpr double Amplitude = 0.7;
+            const double decayPerSample = std::log(Amplitude / decayFloor) / double(std::max<size_t>(numElements - 1, 1));
+            return getTone(index, Amplitude * std::exp(-decayPerSample * double(index)));
+        }
+
+        case Signal::FullScaleEdges:
+        {
+            static const double Edges[] =
+            {
+                1.0, -1.0,
+                1.0 - std::ldexp(1.0, -15), -1.0 + std::ldexp(1.0, -15),
+                1.0 + std::ldexp(1.0, -10), -1.0 - std::ldexp(1.0, -10),
+                0.0, -0.0,
+                std::ldexp(1.0, -15), -std::ldexp(1.0, -15),
+                std::ldexp(1.0, -7), -std::ldexp(1.0, -7)
+            };
+            static constexpr size_t NumEdges = sizeof(Edges) / sizeof(Edges[0]);
+
+            // Offset, so real and imaginary parts pair differently
+            return std::complex<double>(Edges[index % NumEdges], Edges[(index + 5) % NumEdges]);
+        }
+
+        default:
+            throw std::invalid_argument("getSignalSample: " + getSignalName(signal) + " has no samples");
+        }
+    }
+
+    size_t getLastLevelCacheBytes()
+    {
+        size_t bytes = 0;
+
+#ifdef __linux__
+        // Each cache level the CPU has, with sizes like "32768K"
+        for (size_t index = 0; ; ++index)
+        {
+            std::ifstream sizeFile("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/size");
+            if (!sizeFile) break;
+
+            size_t size = 0;
+            char unit = '\0';
+            sizeFile >> size >> unit;
+            if (unit == 'K') size *= 1024;
+            else if (unit == 'M') size *= 1024 * 1024;
+
+            bytes = std::max(bytes, size);
+        }
+#endif
+
+        return bytes;
     }
 }
@@ -3,14 +3,20 @@
 
 #pragma once
 
+#include "ModuleLoader.hpp"
+
 #include <volk/volk_alloc.hh>
 
 #include <algorithm>
 #include <cmath>
 #include <complex>
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 namespace TestUtility
 {
@@ -48,47 +54,253 @@ namespace TestUtility
     template <typename T, typename Ret>
     using EnableIfComplex = typename std::enable_if<IsComplex<T>::value, Ret>::type;
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    //
+    // Random values
+    //
+
+    // xoshiro256++ in independent lanes, so filling a buffer is a loop
+    // across lanes the compiler vectorizes. Every lane is seeded from one
+    // 64-bit seed with splitmix64, so a seed reproduces every buffer filled
+    // from it, in order. Also a UniformRandomBitGenerator for <random>'s
+    // distributions. Not thread-safe.
+    class RandomGenerator
+    {
+    public:
+        static constexpr size_t Lanes = 8;
+
+        using result_type = uint64_t;
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~result_type(0); }
+
+        explicit RandomGenerator(uint64_t seed);
+
+        void seed(uint64_t seed);
+
+        // One value from each lane
+        inline void nextBlock(uint64_t* block)
+        {
+            for (size_t lane = 0; lane < Lanes; ++lane)
+            {
+                block[lane] = rotl(_state[0][lane] + _state[3][lane], 23) + _state[0][lane];
+
+                const uint64_t shifted = _state[1][lane] << 17;
+                _state[2][lane] ^= _state[0][lane];
+                _state[3][lane] ^= _state[1][lane];
+                _state[1][lane] ^= _state[2][lane];
+                _state[0][lane] ^= _state[3][lane];
+                _state[2][lane] ^= shifted;
+                _state[3][lane] = rotl(_state[3][lane], 45);
+            }
+        }
+
+        inline result_type operator()()
+        {
+            if (_next == Lanes)
+            {
+                nextBlock(_block);
+                _next = 0;
+            }
+
+            return _block[_next++];
+        }
+
+        // Maps each random word to a value with convert(word).
+        template <typename T, typename Convert>
+        void fill(T* values, size_t numValues, Convert convert)
+        {
+            alignas(64) uint64_t block[Lanes];
+
+            size_t i = 0;
+            for (; (i + Lanes) <= numValues; i += Lanes)
+            {
+                nextBlock(block);
+                for (size_t lane = 0; lane < Lanes; ++lane) values[i + lane] = convert(block[lane]);
+            }
+            if (i < numValues)
+            {
+                nextBlock(block);
+                for (size_t lane = 0; (i + lane) < numValues; ++lane) values[i + lane] = convert(block[lane]);
+            }
+        }
+
+    private:
+        static inline uint64_t rotl(const uint64_t value, const int shift)
+        {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+        alignas(64) uint64_t _state[4][Lanes];
+        uint64_t _block[Lanes];
+        size_t _next{Lanes};
+    };
+
+    // Shared by everything in TestUtility, seeded from std::random_device
+    // unless setRandomSeed() is called first
+    RandomGenerator& getRandomGenerator();
+
+    void setRandomSeed(uint64_t seed);
+
+    // The seed the generator was last seeded with, to reproduce a run
+    uint64_t getRandomSeed();
+
+    // Uniform in [0, 127] for bytes, [0, max] for other integers, and [0, 1)
+    // for floating-point types, as raw words' top bits
+    template <typename T>
+    static EnableIfByte<T, T> fromRandomWord(uint64_t word)
+    {
+        return T(word >> 57);
+    }
 
     template <typename T>
-    static EnableIfByte<T, T> getRandomValue()
+    static EnableIfIntegral<T, T> fromRandomWord(uint64_t word)
     {
-        static std::uniform_int_distribution<int> dist(0, 127);
-        return T(dist(gen));
+        return T(word >> (64 - std::numeric_limits<T>::digits));
     }
 
     template <typename T>
-    static EnableIfIntegral<T, T> getRandomValue()
+    static EnableIfFloatingPoint<T, T> fromRandomWord(uint64_t word)
     {
-        static std::uniform_int_distribution<T> dist(T(0), std::numeric_limits<T>::max());
-        return dist(gen);
+        constexpr int bits = std::numeric_limits<T>::digits;
+        return T(word >> (64 - bits)) * (T(1.0) / T(uint64_t(1) << bits));
     }
 
     template <typename T>
-    static EnableIfFloatingPoint<T, T> getRandomValue()
+    static EnableIfNotComplex<T, void> fillRandomValues(T* values, size_t numElements)
     {
-        static std::uniform_real_distribution<T> dist(T(0.0), T(1.0));
-        return dist(gen);
+        getRandomGenerator().fill(values, numElements, fromRandomWord<T>);
     }
 
+    // Real and imaginary parts are laid out like an array of two scalars.
     template <typename T>
-    static EnableIfComplex<T, T> getRandomValue()
+    static EnableIfComplex<T, void> fillRandomValues(T* values, size_t numElements)
     {
         using ScalarType = typename T::value_type;
-        return T(getRandomValue<ScalarType>(), getRandomValue<ScalarType>());
+        fillRandomValues(reinterpret_cast<ScalarType*>(values), (numElements * 2));
     }
 
     template <typename T>
     static volk::vector<T> getRandomValues(size_t numElements)
     {
-        volk::vector<T> randomValues;
-        for (size_t i = 0; i < numElements; ++i) randomValues.emplace_back(getRandomValue<T>());
+        volk::vector<T> randomValues(numElements);
+        fillRandomValues(randomValues.data(), numElements);
 
         return randomValues;
     }
 
-    bool loadSoapyVOLK();
+    // Bursts of random values separated by runs of exact zeros, like a
+    // burst transmitter's TX buffers
+    template <typename T>
+    static volk::vector<T> getSparseBurstValues(
+        size_t numElements,
+        size_t burstLength,
+        size_t period)
+    {
+        auto values = getRandomValues<T>(numElements);
+        for (size_t i = 0; i < numElements; ++i)
+        {
+            if ((i % period) >= burstLength) values[i] = T(0);
+        }
+
+        return values;
+    }
+
+    //
+    // Signals
+    //
+
+    // Radio-like inputs, to reach the converters' saturation, zero-skip, and
+    // denormal paths that uniform values don't
+    enum class Signal
+    {
+        Uniform,        // getRandomValues()
+        Tone,           // One complex tone at 0.7 of full scale
+        NoisyTone,      // A tone at 0.5 of full scale in Gaussian noise, at a given SNR
+        ClippedBurst,   // Bursts overdriven to 1.5x full scale between low-level noise
+        SparseZeros,    // Bursts of a noisy tone between runs of exact zeros
+        DenormalDecay,  // A tone decaying to the smallest denormal, or zero for integers
+        FullScaleEdges  // Cycling through +-full scale, just inside and beyond it, +-0, and +-1 LSB
+    };
+
+    const std::vector<Signal>& getSignals();
+
+    std::string getSignalName(Signal signal);
+
+    // Throws if no signal has this name
+    Signal getSignal(const std::string& name);
+
+    // Sample index of numElements, where full scale is 1.0. DenormalDecay
+    // decays to decayFloor, and SNR only applies to noisy signals.
+    std::complex<double> getSignalSample(
+        Signal signal,
+        size_t index,
+        size_t numElements,
+        double snrDB,
+        double decayFloor);
+
+    template <typename T>
+    struct ScalarOf { using type = T; };
+
+    template <typename T>
+    struct ScalarOf<std::complex<T>> { using type = T; };
+
+    template <typename T>
+    static EnableIfFloatingPoint<T, T> fromSignalSample(double sample)
+    {
+        return T(sample);
+    }
+
+    // Scaled to full scale, clamped like a saturating ADC
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value, T>::type fromSignalSample(double sample)
+    {
+        const double scaled = std::round(sample * std::ldexp(1.0, int(8 * sizeof(T)) - 1));
+        return T(std::min<double>(std::max<double>(scaled, std::numeric_limits<T>::min()), std::numeric_limits<T>::max()));
+    }
+
+    template <typename T>
+    static EnableIfNotComplex<T, T> fromSignalSample(const std::complex<double>& sample)
+    {
+        return fromSignalSample<T>(sample.real());
+    }
+
+    template <typename T>
+    static EnableIfComplex<T, T> fromSignalSample(const std::complex<double>& sample)
+    {
+        using ScalarType = typename T::value_type;
+        return T(fromSignalSample<ScalarType>(sample.real()), fromSignalSample<ScalarType>(sample.imag()));
+    }
+
+    template <typename T>
+    static volk::vector<T> getSignalValues(
+        Signal signal,
+        size_t numElements,
+        double snrDB = 20.0)
+    {
+        if (signal == Signal::Uniform) return getRandomValues<T>(numElements);
+
+        using ScalarType = typename ScalarOf<T>::type;
+        const double decayFloor = std::is_floating_point<ScalarType>::value
+            ? double(std::numeric_limits<ScalarType>::denorm_min())
+            : std::ldexp(1.0, 1 - int(8 * sizeof(ScalarType)));
+
+        volk::vector<T> values(numElements);
+        for (size_t i = 0; i < numElements; ++i)
+        {
+            values[i] = fromSignalSample<T>(getSignalSample(signal, i, numElements, snrDB, decayFloor));
+        }
+
+        return values;
+    }
+
+    // Pins the calling thread to one core. Returns false if that isn't
+    // supported on this platform, or fails.
+    bool pinThreadToCore(size_t core);
+
+    // The process's peak resident set size, or 0 if it's unavailable
+    size_t getPeakRSSBytes();
+
+    // The size of the largest CPU cache, or 0 if it's unknown
+    size_t getLastLevelCacheBytes();
 
     template <typename T>
     T median(const volk::vector<T>& inputs)
@@ -99,6 +311,17 @@ namespace TestUtility
         return sortedInputs[sortedInputs.size() / 2];
     }
 
+    // Nearest rank, with fraction in [0, 1]
+    template <typename T>
+    T percentile(const volk::vector<T>& inputs, double fraction)
+    {
+        volk::vector<T> sortedInputs(inputs);
+        std::sort(sortedInputs.begin(), sortedInputs.end());
+
+        const size_t rank = size_t(std::ceil(fraction * sortedInputs.size()));
+        return sortedInputs[std::min(std::max<size_t>(rank, 1), sortedInputs.size()) - 1];
+    }
+
     template <typename T>
     double medAbsDev(const volk::vector<T>& inputs)
     {
@@ -114,16 +337,23 @@ namespace TestUtility
         return median(diffs);
     }
 
+    // In double, as full-scale integers' differences and magnitudes can
+    // overflow their type, clamped back to it
     template <typename T>
     static EnableIfNotComplex<T, T> absDiff(const T& num0, const T& num1)
     {
-        return std::abs(num0 - num1);
+        return T(std::min<double>(std::abs(double(num0) - double(num1)), double(std::numeric_limits<T>::max())));
     }
 
     template <typename T>
     static EnableIfComplex<T, typename T::value_type> absDiff(const T& num0, const T& num1)
     {
-        return std::abs(std::abs(num0) - std::abs(num1));
+        using ScalarType = typename T::value_type;
+
+        const double diff = std::abs(
+            std::abs(std::complex<double>(double(num0.real()), double(num0.imag()))) -
+            std::abs(std::complex<double>(double(num1.real()), double(num1.imag()))));
+        return ScalarType(std::min<double>(diff, double(std::numeric_limits<ScalarType>::max())));
     }
 
     template <typename T>
@@ -0,0 +1,321 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#include "CycleTimer.hpp"
+#include "SoapyVOLKConverters.hpp"
+#include "Tracing.hpp"
+
+#include <SoapySDR/Logger.hpp>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sys/syscall.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SoapyVOLKConverters
+{
+    bool TraceEnabled = false;
+
+    struct TraceEvent
+    {
+        const char* sourceFormat;
+        const char* targetFormat;
+        uint64_t numElems;
+        uint64_t beginTicks;
+        uint64_t endTicks;
+    };
+
+    static constexpr size_t TraceChunkSize = 4096;
+
+    // About 40MB per thread, after which events are dropped and counted.
+    static constexpr size_t MaxTraceChunksPerThread = 256;
+
+    // Only the owning thread writes events. Publishing the size with release
+    // semantics lets the trace be written while threads are still running.
+    struct TraceChunk
+    {
+        std::array<TraceEvent, TraceChunkSize> events;
+        std::atomic<size_t> size{0};
+    };
+
+    struct ThreadTrace
+    {
+        uint64_t threadId{0};
+        std::string threadName;
+
+        // Only grows under the registry mutex, once per chunk.
+        std::vector<std::unique_ptr<TraceChunk>> chunks;
+        TraceChunk* current{nullptr};
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    // Owns every thread's buffer, including threads that have exited, so
+    // nothing needs to happen at thread exit.
+    struct TraceRegistry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadTrace>> threads;
+    };
+
+    static TraceRegistry& getTraceRegistry()
+    {
+        // Leaked, as threads may still be converting while the module's
+        // static destructors run.
+        static TraceRegistry* registry = new TraceRegistry;
+        return *registry;
+    }
+
+    // Set from the module's initializer, which may run before this file's
+    // dynamic initializers.
+    static std::string& getTracePath()
+    {
+        static std::string path;
+        return path;
+    }
+
+    static uint64_t TraceStartTicks = 0;
+
+    static uint64_t getThreadId()
+    {
+#if defined(_WIN32)
+        return GetCurrentThreadId();
+#elif defined(__linux__)
+        return uint64_t(syscall(SYS_gettid));
+#else
+        static std::atomic<uint64_t> nextThreadId(1);
+        return nextThreadId++;
+#endif
+    }
+
+    static std::string getThreadName()
+    {
+#if defined(__linux__)
+        char name[16] = {0};
+        if(0 == pthread_getname_np(pthread_self(), name, sizeof(name))) return name;
+#endif
+        return std::string();
+    }
+
+    static ThreadTrace& getThreadTrace()
+    {
+        static thread_local ThreadTrace* threadTrace = nullptr;
+        if(!threadTrace)
+        {
+            std::unique_ptr<ThreadTrace> newThreadTrace(new ThreadTrace);
+            newThreadTrace->threadId = getThreadId();
+            newThreadTrace->threadName = getThreadName();
+
+            auto& registry = getTraceRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            threadTrace = newThreadTrace.get();
+            registry.threads.push_back(std::move(newThreadTrace));
+        }
+
+        return *threadTrace;
+    }
+
+    void traceConverterCall(
+        const char* sourceFormat,
+        const char* targetFormat,
+        const size_t numElems,
+        const uint64_t beginTicks,
+        const uint64_t endTicks)
+    {
+        auto& threadTrace = getThreadTrace();
+
+        auto* chunk = threadTrace.current;
+        if(!chunk || (chunk->size.load(std::memory_order_relaxed) == TraceChunkSize))
+        {
+            if(threadTrace.chunks.size() == MaxTraceChunksPerThread)
+            {
+                threadTrace.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            auto& registry = getTraceRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            threadTrace.chunks.emplace_back(new TraceChunk);
+            chunk = threadTrace.current = threadTrace.chunks.back().get();
+        }
+
+        const size_t size = chunk->size.load(std::memory_order_relaxed);
+        chunk->events[size] = TraceEvent{sourceFormat, targetFormat, numElems, beginTicks, endTicks};
+        chunk->size.store(size + 1, std::memory_order_release);
+    }
+
+    static std::string escapeJSON(const std::string& str)
+    {
+        std::string escaped;
+        for(const char ch: str)
+        {
+            if((ch == '"') || (ch == '\\'))
+            {
+                escaped += '\\';
+                escaped += ch;
+            }
+            else if(static_cast<unsigned char>(ch) < 0x20)
+            {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", ch);
+                escaped += code;
+            }
+            else escaped += ch;
+        }
+
+        return escaped;
+    }
+
+    static uint64_t getProcessId()
+    {
+#if defined(_WIN32)
+        return GetCurrentProcessId();
+#else
+        return uint64_t(getpid());
+#endif
+    }
+
+    struct UnloadTraceWriter
+    {
+        // Makes sure the path is destroyed after this is.
+        UnloadTraceWriter()
+        {
+            getTracePath();
+        }
+
+        ~UnloadTraceWriter()
+        {
+            if(!TraceEnabled) return;
+
+            const auto& tracePath = getTracePath();
+            const int err = SoapyVOLKConverters_writeTrace(tracePath.c_str());
+            if(err != 0)
+            {
+                SoapySDR::logf(
+                    SOAPY_SDR_ERROR,
+                    "SoapyVOLKConverters: failed to write %s: %s",
+                    tracePath.c_str(),
+                    std::strerror(err));
+            }
+        }
+    };
+
+    static const UnloadTraceWriter TraceWriter;
+
+    void initTrace()
+    {
+        const char* tracePath = std::getenv("SOAPY_VOLK_TRACE");
+        if(!tracePath || !tracePath[0]) return;
+
+        getTracePath() = tracePath;
+        TraceStartTicks = readCycleCounter();
+        TraceEnabled = true;
+
+        SoapySDR::logf(SOAPY_SDR_INFO, "SoapyVOLKConverters: tracing converter calls to %s", tracePath);
+    }
+}
+
+//
+// Exported API
+//
+
+using namespace SoapyVOLKConverters;
+
+bool SoapyVOLKConverters_getTraceEnabled(void)
+{
+    return TraceEnabled;
+}
+
+int SoapyVOLKConverters_writeTrace(const char* path)
+{
+    std::unique_ptr<FILE, int(*)(FILE*)> file(std::fopen(path, "w"), &std::fclose);
+    if(!file) return errno;
+
+    const double ticksPerUs = getTicksPerNanosecond() * 1e3;
+    const uint64_t pid = getProcessId();
+
+    auto& registry = getTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::fprintf(file.get(), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    const char* separator = "\n";
+
+    for(const auto& threadTrace: registry.threads)
+    {
+        const auto tid = (unsigned long long)threadTrace->threadId;
+        if(!threadTrace->threadName.empty())
+        {
+            std::fprintf(
+                file.get(),
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%llu,\"tid\":%llu,\"args\":{\"name\":\"%s\"}}",
+                separator,
+                (unsigned long long)pid,
+                tid,
+                escapeJSON(threadTrace->threadName).c_str());
+            separator = ",\n";
+        }
+
+        for(const auto& chunk: threadTrace->chunks)
+        {
+            const size_t size = chunk->size.load(std::memory_order_acquire);
+            for(size_t i = 0; i < size; ++i)
+            {
+                const auto& event = chunk->events[i];
+                const double beginUs = double(int64_t(event.beginTicks - TraceStartTicks)) / ticksPerUs;
+                const double endUs = double(int64_t(event.endTicks - TraceStartTicks)) / ticksPerUs;
+
+                std::fprintf(
+                    file.get(),
+                    "%s{\"name\":\"%s -> %s\",\"cat\":\"convert\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":%llu,\"tid\":%llu,"
+                    "\"args\":{\"source\":\"%s\",\"target\":\"%s\",\"numElems\":%llu}}"
+                    ",\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":%llu,\"tid\":%llu}",
+                    separator,
+                    event.sourceFormat,
+                    event.targetFormat,
+                    beginUs,
+                    (unsigned long long)pid,
+                    tid,
+                    event.sourceFormat,
+                    event.targetFormat,
+                    (unsigned long long)event.numElems,
+                    endUs,
+                    (unsigned long long)pid,
+                    tid);
+                separator = ",\n";
+            }
+        }
+
+        const uint64_t dropped = threadTrace->dropped.load(std::memory_order_relaxed);
+        if(dropped > 0)
+        {
+            SoapySDR::logf(
+                SOAPY_SDR_WARNING,
+                "SoapyVOLKConverters: thread %llu dropped %llu trace events after its buffer filled",
+                tid,
+                (unsigned long long)dropped);
+        }
+    }
+
+    std::fprintf(file.get(), "\n]}\n");
+
+    return std::ferror(file.get()) ? EIO : 0;
+}
@@ -0,0 +1,27 @@
+// Copyright (c) 2026 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SoapyVOLKConverters
+{
+    // Set once when the module is loaded, so checking it on every call costs
+    // a predictable branch.
+    extern bool TraceEnabled;
+
+    // Enables tracing if SOAPY_VOLK_TRACE is set to the path to write to
+    // when the module is unloaded.
+    void initTrace();
+
+    // Appends a begin/end event pair to the calling thread's buffer. Formats
+    // must outlive the module, as they're only written out at the end.
+    void traceConverterCall(
+        const char* sourceFormat,
+        const char* targetFormat,
+        size_t numElems,
+        uint64_t beginTicks,
+        uint64_t endTicks);
+}
@@ -1,3 +1,5 @@
 #pragma once
 
-#cmakedefine CMAKE_BUILD_TYPE "@CMAKE_BUILD_TYPE@"
\ No newline at end of file
+#cmakedefine CMAKE_BUILD_TYPE "@CMAKE_BUILD_TYPE@"
+#cmakedefine HAVE_LIBURING
+#cmakedefine HAVE_SYS_SDT_H